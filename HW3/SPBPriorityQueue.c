@@ -8,40 +8,320 @@
 #include "SPBPriorityQueue.h"
 #include "SPList.h"
 #include "SPListElement.h"
+#include "SPMinMaxHeap.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <assert.h>
 
 
+/*
+ * The storage (queue or heap) is shared by a BPQ and its copies, and is
+ * counted by references. A BPQ which is about to change shared storage
+ * first makes a private copy of it (copy-on-write).
+ */
 struct sp_bp_queue_t {
 	int maxSize;
-	SPList queue;
+	SP_BPQUEUE_BACKEND backend;
+	SPList queue;						// Used by SP_BPQUEUE_LIST_BACKEND
+	SPMinMaxHeap heap;					// Used by SP_BPQUEUE_MINMAX_HEAP_BACKEND
+	int* references;					// Number of BPQs sharing the storage
+};
+
+struct sp_bp_queue_cursor_t {
+	SPBPQueue queue;
+	bool started;
+	SPListIterator next;				// The next list element, for the list backend
+	int position;
+	SPListElement* order;				// Heap elements sorted, for the heap backend
 };
 
+static bool isHeapBacked(SPBPQueue source) {
+	return source->backend == SP_BPQUEUE_MINMAX_HEAP_BACKEND;
+}
+
+/*
+ * Allocates new empty storage for a BPQ. On failure the BPQ is not changed.
+ */
+static bool createStorage(SPBPQueue source) {
+	SPList queue = NULL;
+	SPMinMaxHeap heap = NULL;
+	int* references = (int*) malloc(sizeof(int));
+	if (isHeapBacked(source)) {
+		heap = spMinMaxHeapCreate(source->maxSize);
+	} else {
+		queue = spListCreateWithPool(NULL);		// Recycles evicted nodes
+	}
+	if (!references || (!queue && !heap)) {			// Allocation failure
+		free(references);
+		spListDestroy(queue);
+		spMinMaxHeapDestroy(heap);
+		return false;
+	}
+	*references = 1;
+	source->queue = queue;
+	source->heap = heap;
+	source->references = references;
+	return true;
+}
+
+/*
+ * Drops the BPQ's reference to its storage, freeing the storage if this
+ * was the last reference.
+ */
+static void releaseStorage(SPBPQueue source) {
+	if (__atomic_sub_fetch(source->references, 1, __ATOMIC_ACQ_REL) == 0) {
+		spListDestroy(source->queue);
+		spMinMaxHeapDestroy(source->heap);
+		free(source->references);
+	}
+	source->queue = NULL;
+	source->heap = NULL;
+	source->references = NULL;
+}
+
+static bool isShared(SPBPQueue source) {
+	return __atomic_load_n(source->references, __ATOMIC_ACQUIRE) > 1;
+}
+
+/*
+ * Makes sure the BPQ is the only owner of its storage, copying the storage
+ * if it is shared. On failure the BPQ is not changed.
+ */
+static bool detachStorage(SPBPQueue source) {
+	SPList queue = NULL;
+	SPMinMaxHeap heap = NULL;
+	int* references;
+	if (!isShared(source)) {
+		return true;
+	}
+	references = (int*) malloc(sizeof(int));
+	if (isHeapBacked(source)) {
+		heap = spMinMaxHeapCopy(source->heap);
+	} else {
+		queue = spListCopy(source->queue);
+	}
+	if (!references || (!queue && !heap)) {			// Allocation failure
+		free(references);
+		spListDestroy(queue);
+		spMinMaxHeapDestroy(heap);
+		return false;
+	}
+	releaseStorage(source);
+	*references = 1;
+	source->queue = queue;
+	source->heap = heap;
+	source->references = references;
+	return true;
+}
+
+/*
+ * Empties the BPQ. Shared storage is left to its other owners instead of
+ * being copied. On failure the BPQ is not changed.
+ */
+static bool resetStorage(SPBPQueue source) {
+	SPList queue = source->queue;
+	SPMinMaxHeap heap = source->heap;
+	int* references = source->references;
+	if (!isShared(source)) {
+		spListClear(source->queue);
+		spMinMaxHeapClear(source->heap);
+		return true;
+	}
+	if (!createStorage(source)) {
+		return false;
+	}
+	if (__atomic_sub_fetch(references, 1, __ATOMIC_ACQ_REL) == 0) {
+		spListDestroy(queue);						// Other owners left meanwhile
+		spMinMaxHeapDestroy(heap);
+		free(references);
+	}
+	return true;
+}
+
 SPBPQueue spBPQueueCreate(int maxSize) {
+	return spBPQueueCreateWithBackend(maxSize, SP_BPQUEUE_LIST_BACKEND);
+}
+
+SPBPQueue spBPQueueCreateWithBackend(int maxSize, SP_BPQUEUE_BACKEND backend) {
+	SPBPQueue this;
 	if (maxSize < 1) {								// Invalid Size Bound
 		return NULL;
 	}
-	SPBPQueue this = (SPBPQueue) malloc(sizeof(struct sp_bp_queue_t));
-	SPList queue = spListCreate();
-	if (!this || !queue) {							// Allocation failure
+	if (backend != SP_BPQUEUE_LIST_BACKEND &&
+			backend != SP_BPQUEUE_MINMAX_HEAP_BACKEND) {	// Invalid backend
+		return NULL;
+	}
+	this = (SPBPQueue) malloc(sizeof(struct sp_bp_queue_t));
+	if (!this) {									// Allocation failure
 		return NULL;
 	}
 	this->maxSize = maxSize;
-	this->queue = queue;
+	this->backend = backend;
+	if (!createStorage(this)) {						// Allocation failure
+		free(this);
+		return NULL;
+	}
 	return this;
 }
 
-SPBPQueue spBPQueueCopy(SPBPQueue source) {
+SP_BPQUEUE_BACKEND spBPQueueGetBackend(SPBPQueue source) {
+	assert(source != NULL);
+	return source->backend;
+}
+
+static int entryCompare(const SPListElementValue* e1, const SPListElementValue* e2) {
+	return spListElementValueCompare(*e1, *e2);
+}
+
+static int entryCompareQsort(const void* e1, const void* e2) {
+	return entryCompare((const SPListElementValue*) e1, (const SPListElementValue*) e2);
+}
+
+static void entrySwap(SPListElementValue* entries, int i, int j) {
+	SPListElementValue temp = entries[i];
+	entries[i] = entries[j];
+	entries[j] = temp;
+}
+
+/*
+ * Restores the max-heap property of entries[0..size) below the given root.
+ */
+static void entrySiftDown(SPListElementValue* entries, int root, int size) {
+	int child;
+	while ((child = 2 * root + 1) < size) {
+		if (child + 1 < size && entryCompare(&entries[child + 1], &entries[child]) > 0) {
+			child++;
+		}
+		if (entryCompare(&entries[child], &entries[root]) <= 0) {
+			return;
+		}
+		entrySwap(entries, root, child);
+		root = child;
+	}
+}
+
+/*
+ * Moves the k minimal entries of entries[0..n) to entries[0..k) using a
+ * bounded max-heap. Used as the guaranteed O(n log k) fallback.
+ */
+static void entryHeapSelect(SPListElementValue* entries, int n, int k) {
+	int i;
+	for (i = k / 2 - 1; i >= 0; i--) {
+		entrySiftDown(entries, i, k);
+	}
+	for (i = k; i < n; i++) {
+		if (entryCompare(&entries[i], &entries[0]) < 0) {
+			entrySwap(entries, 0, i);
+			entrySiftDown(entries, 0, k);
+		}
+	}
+}
+
+/*
+ * Introselect: moves the k minimal entries of entries[0..n) to
+ * entries[0..k), in no particular order. Quickselect with a median of
+ * three pivot, falling back to heap selection once the recursion depth
+ * exceeds 2*log2(n).
+ */
+static void entrySelect(SPListElementValue* entries, int n, int k) {
+	int left = 0, right = n - 1, depth = 0, size;
+	int i, j, middle;
+	SPListElementValue pivot;
+	for (size = n; size > 1; size /= 2) {
+		depth += 2;
+	}
+	while (right > left) {
+		if (depth-- == 0) {
+			entryHeapSelect(entries + left, right - left + 1, k - left);
+			return;
+		}
+		middle = left + (right - left) / 2;			// Median of three pivot
+		if (entryCompare(&entries[middle], &entries[left]) < 0) {
+			entrySwap(entries, middle, left);
+		}
+		if (entryCompare(&entries[right], &entries[left]) < 0) {
+			entrySwap(entries, right, left);
+		}
+		if (entryCompare(&entries[right], &entries[middle]) < 0) {
+			entrySwap(entries, right, middle);
+		}
+		pivot = entries[middle];
+		i = left;
+		j = right;
+		while (i <= j) {								// Hoare partition
+			while (entryCompare(&entries[i], &pivot) < 0) {
+				i++;
+			}
+			while (entryCompare(&entries[j], &pivot) > 0) {
+				j--;
+			}
+			if (i <= j) {
+				entrySwap(entries, i, j);
+				i++;
+				j--;
+			}
+		}
+		if (k <= j + 1) {								// Wanted boundary is on the left
+			right = j;
+		} else if (k > i) {								// Wanted boundary is on the right
+			left = i;
+		} else {										// entries[j+1..i) equal the pivot
+			return;
+		}
+	}
+}
+
+SPBPQueue spBPQueueBuildFromArray(int k, const int* indexes, const double* values, int n) {
 	SPBPQueue this;
-	SPList queue;
+	SPListElementValue* entries;
+	int i, size;
 
-	if (!source) {									// Invalid input
+	if (k < 1 || n < 0 || !indexes || !values) {	// Invalid input
 		return NULL;
 	}
+	for (i = 0; i < n; i++) {
+		if (indexes[i] < 0 || values[i] < 0.0) {	// Invalid element
+			return NULL;
+		}
+	}
 
-	queue = spListCopy(source->queue);
-	if (!queue) {									// Allocation failure
+	this = spBPQueueCreate(k);
+	if (!this) {									// Allocation failure
+		return NULL;
+	}
+	if (n == 0) {
+		return this;
+	}
+	entries = (SPListElementValue*) malloc(sizeof(SPListElementValue) * n);
+	if (!entries) {									// Allocation failure
+		spBPQueueDestroy(this);
+		return NULL;
+	}
+	for (i = 0; i < n; i++) {
+		entries[i] = spListElementValueCreate(indexes[i], values[i]);
+	}
+
+	size = n < k ? n : k;
+	if (n > k) {
+		entrySelect(entries, n, k);
+	}
+	qsort(entries, size, sizeof(SPListElementValue), entryCompareQsort);
+
+	for (i = 0; i < size; i++) {					// Append the survivors in order
+		if (spListInsertLastValue(this->queue, entries[i]) != SP_LIST_SUCCESS) {
+			free(entries);
+			spBPQueueDestroy(this);
+			return NULL;
+		}
+	}
+	free(entries);
+	return this;
+}
+
+SPBPQueue spBPQueueCopy(SPBPQueue source) {
+	SPBPQueue this;
+
+	if (!source) {									// Invalid input
 		return NULL;
 	}
 
@@ -50,8 +330,8 @@ SPBPQueue spBPQueueCopy(SPBPQueue source) {
 		return NULL;
 	}
 
-	this->maxSize = source->maxSize;
-	this->queue = queue;
+	*this = *source;								// Share the storage
+	__atomic_add_fetch(this->references, 1, __ATOMIC_RELAXED);
 	return this;
 }
 
@@ -59,7 +339,7 @@ void spBPQueueDestroy(SPBPQueue source) {
 	if (!source) {									// NULL input
 		return;
 	}
-	spListDestroy(source->queue);
+	releaseStorage(source);
 	free(source);
 }
 
@@ -67,13 +347,16 @@ void spBPQueueClear(SPBPQueue source) {
 	if (!source) {									// NULL input
 		return;
 	}
-	spListClear(source->queue);
+	resetStorage(source);
 }
 
 int spBPQueueSize(SPBPQueue source) {
 	if (!source) {									// Invalid input
 		return -1;
 	}
+	if (isHeapBacked(source)) {
+		return spMinMaxHeapGetSize(source->heap);
+	}
 	return spListGetSize(source->queue);
 }
 
@@ -85,46 +368,54 @@ int spBPQueueGetMaxSize(SPBPQueue source) {
 }
 
 SP_BPQUEUE_MSG spBPQueueEnqueue(SPBPQueue source, SPListElement element) {
-	SPListElement i;
-	SPListElement input;
 	if (!element || !source) {						// Invalid input
 		return SP_BPQUEUE_INVALID_ARGUMENT;
 	}
-	input = spListElementCopy(element);
-	if (!input) {									// Allocation Failure
+	return spBPQueueEnqueueValue(source, *element);
+}
+
+SP_BPQUEUE_MSG spBPQueueEnqueueValue(SPBPQueue source, SPListElementValue element) {
+	SPListElement i;
+	if (!source || !spListElementValueIsValid(element)) {	// Invalid input
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	if (spBPQueueIsFull(source)) {					// QUEUE IS FULL
+		i = isHeapBacked(source) ? spMinMaxHeapGetMax(source->heap) :
+				spListPeekLast(source->queue);
+		if (!spListElementValueIsLess(element, *i)) {	// Input element's value is greater or
+			return SP_BPQUEUE_FULL;					// equals the current maximal value
+		}
+	}
+	if (!detachStorage(source)) {					// Allocation failure
 		return SP_BPQUEUE_OUT_OF_MEMORY;
 	}
-	if (spBPQueueIsEmpty(source)) {
-		spListInsertFirst(source->queue, input);
-		spListElementDestroy(input);
+	if (isHeapBacked(source)) {						// No copies, O(log k)
+		if (spBPQueueIsFull(source)) {
+			spMinMaxHeapRemoveMax(source->heap);
+		}
+		spMinMaxHeapInsert(source->heap, &element);
 		return SP_BPQUEUE_SUCCESS;
 	}
+	if (spBPQueueIsEmpty(source)) {
+		return spListInsertFirstValue(source->queue, element) == SP_LIST_SUCCESS ?
+				SP_BPQUEUE_SUCCESS : SP_BPQUEUE_OUT_OF_MEMORY;
+	}
 
-	if (spBPQueueIsFull(source)) {					// QUEUE IS FULL
-		i = spBPQueuePeekLast(source);
-		if (spListElementCompare(input, i) != -1) {	// Input element's value is greater or
-			spListElementDestroy(i);				// equals the current maximal value
-			spListElementDestroy(input);
-			return SP_BPQUEUE_FULL;
-		}
-		else {										// Input should be inserted
-			spListRemoveCurrent(source->queue);
-			spListElementDestroy(i);
-		}
+	if (spBPQueueIsFull(source)) {					// Input should be inserted,
+		spListGetLast(source->queue);				// remove the maximal element
+		spListRemoveCurrent(source->queue);
 	}
 
 	i = spListGetFirst(source->queue);
 	while (i != NULL) {								// Iterate over the queue
-		if (spListElementCompare(input, i) != 1) {	// input->value <= i->value
-			spListInsertBeforeCurrent(source->queue, input);
-			spListElementDestroy(input);
-			return SP_BPQUEUE_SUCCESS;
+		if (!spListElementValueIsLess(*i, element)) {	// input->value <= i->value
+			return spListInsertBeforeCurrentValue(source->queue, element) ==
+					SP_LIST_SUCCESS ? SP_BPQUEUE_SUCCESS : SP_BPQUEUE_OUT_OF_MEMORY;
 		}
 		i = spListGetNext(source->queue);
 	}
-	spListInsertLast(source->queue, input);
-	spListElementDestroy(input);
-	return SP_BPQUEUE_SUCCESS;
+	return spListInsertLastValue(source->queue, element) == SP_LIST_SUCCESS ?
+			SP_BPQUEUE_SUCCESS : SP_BPQUEUE_OUT_OF_MEMORY;
 }
 
 SP_BPQUEUE_MSG spBPQueueDequeue(SPBPQueue source) {
@@ -134,6 +425,13 @@ SP_BPQUEUE_MSG spBPQueueDequeue(SPBPQueue source) {
 	if (spBPQueueIsEmpty(source)) {
 		return SP_BPQUEUE_EMPTY;
 	}
+	if (!detachStorage(source)) {					// Allocation failure
+		return SP_BPQUEUE_OUT_OF_MEMORY;
+	}
+	if (isHeapBacked(source)) {
+		spMinMaxHeapRemoveMin(source->heap);
+		return SP_BPQUEUE_SUCCESS;
+	}
 	spListGetFirst(source->queue);
 	spListRemoveCurrent(source->queue);
 	return SP_BPQUEUE_SUCCESS;
@@ -143,50 +441,161 @@ SPListElement spBPQueuePeek(SPBPQueue source) {
 	if (!source || spBPQueueIsEmpty(source)) {
 		return NULL;
 	}
-	return spListElementCopy(spListGetFirst(source->queue));
+	if (isHeapBacked(source)) {
+		return spListElementCopy(spMinMaxHeapGetMin(source->heap));
+	}
+	return spListElementCopy(spListPeekFirst(source->queue));
 }
 
 SPListElement spBPQueuePeekLast(SPBPQueue source) {
 	if (!source || spBPQueueIsEmpty(source)) {
 		return NULL;
 	}
-	return spListElementCopy(spListGetLast(source->queue));
+	if (isHeapBacked(source)) {
+		return spListElementCopy(spMinMaxHeapGetMax(source->heap));
+	}
+	return spListElementCopy(spListPeekLast(source->queue));
 }
 
-double spBPQueueMinValue(SPBPQueue source) {
-	SPListElement minElement;
-	double minValue;
+SP_BPQUEUE_MSG spBPQueuePeekValue(SPBPQueue source, SPListElementValue* element) {
+	if (!source || !element) {						// Invalid input
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	if (spBPQueueIsEmpty(source)) {
+		return SP_BPQUEUE_EMPTY;
+	}
+	*element = isHeapBacked(source) ? *spMinMaxHeapGetMin(source->heap) :
+			*spListPeekFirst(source->queue);
+	return SP_BPQUEUE_SUCCESS;
+}
 
-	if (!source || spBPQueueIsEmpty(source)) {
-		return -1;
+SP_BPQUEUE_MSG spBPQueuePeekLastValue(SPBPQueue source, SPListElementValue* element) {
+	if (!source || !element) {						// Invalid input
+		return SP_BPQUEUE_INVALID_ARGUMENT;
 	}
+	if (spBPQueueIsEmpty(source)) {
+		return SP_BPQUEUE_EMPTY;
+	}
+	*element = isHeapBacked(source) ? *spMinMaxHeapGetMax(source->heap) :
+			*spListPeekLast(source->queue);
+	return SP_BPQUEUE_SUCCESS;
+}
 
-	minElement = spBPQueuePeek(source);
-	minValue = spListElementGetValue(minElement);
-	spListElementDestroy(minElement);
-	return minValue;
+double spBPQueueMinValue(SPBPQueue source) {
+	SPListElementValue minElement;
+	if (spBPQueuePeekValue(source, &minElement) != SP_BPQUEUE_SUCCESS) {
+		return -1;
+	}
+	return spListElementValueGetValue(minElement);
 }
 
 double spBPQueueMaxValue(SPBPQueue source) {
-	SPListElement maxElement;
-	double maxValue;
-
-	if (!source || spBPQueueIsEmpty(source)) {
+	SPListElementValue maxElement;
+	if (spBPQueuePeekLastValue(source, &maxElement) != SP_BPQUEUE_SUCCESS) {
 		return -1;
 	}
-
-	maxElement = spBPQueuePeekLast(source);
-	maxValue = spListElementGetValue(maxElement);
-	spListElementDestroy(maxElement);
-	return maxValue;
+	return spListElementValueGetValue(maxElement);
 }
 
 bool spBPQueueIsEmpty(SPBPQueue source) {
 	assert(source != NULL);
-	return (spListGetSize(source->queue) == 0);
+	return (spBPQueueSize(source) == 0);
 }
 
 bool spBPQueueIsFull(SPBPQueue source) {
 	assert(source != NULL);
-	return (spListGetSize(source->queue) == source->maxSize);
+	return (spBPQueueSize(source) == source->maxSize);
+}
+
+SP_BPQUEUE_MSG spBPQueueDrainSorted(SPBPQueue source, int* indexes, double* values) {
+	SPBPQueueCursor cursor;
+	SPListElement i;
+	int position = 0;
+	if (!source || !indexes || !values) {			// Invalid input
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	if (isHeapBacked(source) && !isShared(source)) {	// Sort in place
+		while ((i = spMinMaxHeapGetMin(source->heap)) != NULL) {
+			indexes[position] = spListElementGetIndex(i);
+			values[position] = spListElementGetValue(i);
+			position++;
+			spMinMaxHeapRemoveMin(source->heap);
+		}
+		return SP_BPQUEUE_SUCCESS;
+	}
+	cursor = spBPQueueCursorCreate(source);			// Shared storage is only read
+	if (!cursor) {									// Allocation failure
+		return SP_BPQUEUE_OUT_OF_MEMORY;
+	}
+	while ((i = spBPQueueCursorNext(cursor)) != NULL) {
+		indexes[position] = spListElementGetIndex(i);
+		values[position] = spListElementGetValue(i);
+		position++;
+	}
+	spBPQueueCursorDestroy(cursor);
+	if (!resetStorage(source)) {					// Allocation failure
+		return SP_BPQUEUE_OUT_OF_MEMORY;
+	}
+	return SP_BPQUEUE_SUCCESS;
+}
+
+static int elementCompareQsort(const void* e1, const void* e2) {
+	return spListElementCompare(*(const SPListElement*) e1, *(const SPListElement*) e2);
+}
+
+SPBPQueueCursor spBPQueueCursorCreate(SPBPQueue source) {
+	SPBPQueueCursor this;
+	int i, size;
+	if (!source) {									// Invalid input
+		return NULL;
+	}
+	this = (SPBPQueueCursor) malloc(sizeof(struct sp_bp_queue_cursor_t));
+	if (!this) {									// Allocation failure
+		return NULL;
+	}
+	this->queue = source;
+	this->started = false;
+	this->position = 0;
+	this->order = NULL;
+	size = spBPQueueSize(source);
+	if (isHeapBacked(source) && size > 0) {			// Sort pointers, not elements
+		this->order = (SPListElement*) malloc(sizeof(SPListElement) * size);
+		if (!this->order) {							// Allocation failure
+			free(this);
+			return NULL;
+		}
+		for (i = 0; i < size; i++) {
+			this->order[i] = spMinMaxHeapGetAt(source->heap, i);
+		}
+		qsort(this->order, size, sizeof(SPListElement), elementCompareQsort);
+	}
+	return this;
+}
+
+SPListElement spBPQueueCursorNext(SPBPQueueCursor cursor) {
+	SPListElement element;
+	if (!cursor) {									// Invalid input
+		return NULL;
+	}
+	if (isHeapBacked(cursor->queue)) {
+		if (cursor->position >= spBPQueueSize(cursor->queue)) {
+			return NULL;
+		}
+		return cursor->order[cursor->position++];
+	}
+	if (!cursor->started) {
+		cursor->started = true;
+		cursor->next = spListIteratorFirst(cursor->queue->queue);
+	}
+	element = spListIteratorGet(cursor->next);
+	cursor->next = spListIteratorNext(cursor->next);
+	return element;
+}
+
+void spBPQueueCursorDestroy(SPBPQueueCursor cursor) {
+	if (!cursor) {									// NULL input
+		return;
+	}
+	free(cursor->order);
+	free(cursor);
 }
@@ -5,33 +5,57 @@
 /**
  * Bounded Priority-Queue Summary
  *
- * Implementation of a Bounded Priority-Queue (BPQ) using a singly linked list.
- * The queue itself is of type SPList, please refer to SPList.h for usage.
- * The elements of the queue are of type SPListElement, please refer
- * to SPListElement.h for usage.
+ * Implementation of a Bounded Priority-Queue (BPQ). The elements of the queue
+ * are of type SPListElement, please refer to SPListElement.h for usage.
+ *
+ * A BPQ is stored by one of the following backends, chosen at creation:
+ *   SP_BPQUEUE_LIST_BACKEND		- A sorted SPList (the default). Please refer to
+ *   								  SPList.h for usage.
+ *   SP_BPQUEUE_MINMAX_HEAP_BACKEND	- An SPMinMaxHeap. Both ends of the queue are
+ *   								  found in O(1) and insertion and removal take
+ *   								  O(log k). Please refer to SPMinMaxHeap.h.
  *
  * The following functions are available:
  *
  *   spBPQueueCreate		- Creates a new empty BPQ.
+ *   spBPQueueCreateWithBackend	- Creates a new empty BPQ stored by a given backend.
+ *   spBPQueueGetBackend	- Returns the backend of a BPQ.
+ *   spBPQueueBuildFromArray	- Creates a new BPQ holding the k minimal elements of arrays.
  *   spBPQueueCopy			- Copies an existing BPQ.
  *   spBPQueueDestroy		- Frees all memory allocations associated with a BPQ.
  *   spBPQueueClear			- Clears all elements from a BPQ.
  *   spBPQueueSize			- Returns the current number of elements.
  *   spBPQueueGetMaxSize	- Returns a BPQ's size bound.
  *   spBPQueueEnqueue		- Inserts a new element into a BPQ.
+ *   spBPQueueEnqueueValue	- Inserts a new element, given by value, into a BPQ.
  *   spBPQueueDequeue		- Removes the minimal element from a BPQ.
  *   spBPQueuePeek			- Returns the element whose value is minimal.
  *   spBPQueuePeekLast		- Returns the element whose value is maximal.
+ *   spBPQueuePeekValue		- Copies out the element whose value is minimal.
+ *   spBPQueuePeekLastValue	- Copies out the element whose value is maximal.
  *   spBPQueueMinValue		- Returns the BPQ's minimal value.
  *   spBPQueueMaxValue		- Returns the BPQ's maximal value.
  *   spBPQueueIsEmpty       - Decides whether a BPQ is empty.
  *   spBPQueueIsFull		- Decides whether a BPQ is full.
+ *   spBPQueueDrainSorted	- Moves all elements of a BPQ into arrays, in order.
+ *   spBPQueueCursorCreate	- Creates a read-only cursor over a BPQ.
+ *   spBPQueueCursorNext	- Advances a cursor and returns the next element.
+ *   spBPQueueCursorDestroy	- Frees all memory allocations associated with a cursor.
  */
 
 
 /** type used to define Bounded priority queue **/
 typedef struct sp_bp_queue_t* SPBPQueue;
 
+/** type used to iterate over a BPQ without copying its elements **/
+typedef struct sp_bp_queue_cursor_t* SPBPQueueCursor;
+
+/** type used to choose how a BPQ stores its elements **/
+typedef enum sp_bp_queue_backend_t {
+	SP_BPQUEUE_LIST_BACKEND,
+	SP_BPQUEUE_MINMAX_HEAP_BACKEND
+} SP_BPQUEUE_BACKEND;
+
 /** type for error reporting **/
 typedef enum sp_bp_queue_msg_t {
 	SP_BPQUEUE_OUT_OF_MEMORY,
@@ -52,7 +76,55 @@ typedef enum sp_bp_queue_msg_t {
 SPBPQueue spBPQueueCreate(int maxSize);
 
 /**
- * Creates a copy of a given BPQ.
+ * Creates a new BPQ with the given size bound, stored by the given backend.
+ * spBPQueueCreate(maxSize) is the same as using SP_BPQUEUE_LIST_BACKEND.
+ *
+ * @param maxSize - The size bound of the queue.
+ * @param backend - The backend storing the queue's elements.
+ * @return
+ * NULL in case of a memory allocation failure, if the input bound is less than 1
+ * 	or if backend is not a valid backend;
+ * The new BPQ otherwise.
+ */
+SPBPQueue spBPQueueCreateWithBackend(int maxSize, SP_BPQUEUE_BACKEND backend);
+
+/**
+ * Returns the backend which stores the elements of a given BPQ.
+ *
+ * @param source - The query queue.
+ * @assert source != NULL
+ * @return
+ * The backend of the queue.
+ */
+SP_BPQUEUE_BACKEND spBPQueueGetBackend(SPBPQueue source);
+
+/**
+ * Creates a new BPQ with the size bound k which holds the k minimal
+ * elements (with respect to spListElementCompare) among the n elements
+ * given by indexes and values, where the i-th element is
+ * (indexes[i], values[i]). The result is the same as enqueueing all
+ * n elements, but the k minimal elements are selected in expected linear
+ * time and only they are sorted.
+ *
+ * @param k - The size bound of the new queue.
+ * @param indexes - The indexes of the candidate elements.
+ * @param values - The values of the candidate elements.
+ * @param n - The number of candidate elements.
+ * @return
+ * NULL in case of a memory allocation failure, if k is less than 1, if n is
+ * 	negative, if the arrays are NULL or if any index or value is negative;
+ * The new BPQ otherwise.
+ */
+SPBPQueue spBPQueueBuildFromArray(int k, const int* indexes, const double* values, int n);
+
+/**
+ * Creates a copy of a given BPQ in O(1). The copy shares its elements with
+ * the source until either of them is changed, and only then the changed
+ * queue copies the elements (copy-on-write). A copy may be handed to another
+ * thread and read there while the source keeps changing, which allows
+ * publishing snapshots of a queue. The copy itself must be made by the
+ * thread which owns the source. Reading a queue never changes it, so a
+ * snapshot may be read by several threads at once.
  *
  * @param source - The queue to be copied.
  * @return
@@ -72,6 +144,8 @@ void spBPQueueDestroy(SPBPQueue source);
 /**
  * Clears a BPQ of all its elements.
  * Does nothing if given a NULL argument (or if the queue is already empty).
+ * If the elements are shared with a copy and a memory allocation fails, the
+ * queue is not changed.
  *
  * @param source - The queue to be cleared.
  */
@@ -114,6 +188,21 @@ int spBPQueueGetMaxSize(SPBPQueue source);
  */
 SP_BPQUEUE_MSG spBPQueueEnqueue(SPBPQueue source, SPListElement element);
 
+/**
+ * Same as spBPQueueEnqueue, but the new element is given by value, so no
+ * element handle has to be allocated by the caller or by the BPQ.
+ *
+ * @param source - The input BPQ.
+ * @param element - The new element to insert.
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if given a NULL queue, or an element with a negative index or value;
+ * SP_BPQUEUE_OUT_OF_MEMORY in case of a memory allocation failure;
+ * SP_BPQUEUE_FULL if the queue is full AND the new element's value
+ *  is greater or equals the current maximal value of the BPQ;
+ * SP_BPQUEUE_SUCCESS otherwise (i.e. the insertion succeeded).
+ */
+SP_BPQUEUE_MSG spBPQueueEnqueueValue(SPBPQueue source, SPListElementValue element);
+
 /**
  * Removes the minimal element from a given BPQ.
  * If there are several elements holding the minimal value, the element
@@ -150,6 +239,32 @@ SPListElement spBPQueuePeek(SPBPQueue source);
  */
 SPListElement spBPQueuePeekLast(SPBPQueue source);
 
+/**
+ * Copies the minimal (first) element of a given BPQ into element. Unlike
+ * spBPQueuePeek, nothing is allocated.
+ *
+ * @param source - The query queue.
+ * @param element - Receives the minimal element.
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if given NULL arguments;
+ * SP_BPQUEUE_EMPTY if the queue is empty;
+ * SP_BPQUEUE_SUCCESS otherwise.
+ */
+SP_BPQUEUE_MSG spBPQueuePeekValue(SPBPQueue source, SPListElementValue* element);
+
+/**
+ * Copies the maximal (last) element of a given BPQ into element. Unlike
+ * spBPQueuePeekLast, nothing is allocated.
+ *
+ * @param source - The query queue.
+ * @param element - Receives the maximal element.
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if given NULL arguments;
+ * SP_BPQUEUE_EMPTY if the queue is empty;
+ * SP_BPQUEUE_SUCCESS otherwise.
+ */
+SP_BPQUEUE_MSG spBPQueuePeekLastValue(SPBPQueue source, SPListElementValue* element);
+
 /**
  * Returns the minimal value of a given BPQ.
  *
@@ -192,4 +307,55 @@ bool spBPQueueIsEmpty(SPBPQueue source);
  */
 bool spBPQueueIsFull(SPBPQueue source);
 
+/**
+ * Moves all elements of a given BPQ into the given arrays, from the minimal
+ * element to the maximal one, and leaves the queue empty. The i-th element
+ * is written to indexes[i] and values[i]. No element copies are allocated,
+ * and elements shared with a copy of the queue are only read.
+ * The arrays must be able to hold spBPQueueSize(source) entries.
+ *
+ * @param source - The input BPQ.
+ * @param indexes - The array receiving the elements' indexes.
+ * @param values - The array receiving the elements' values.
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if given NULL arguments;
+ * SP_BPQUEUE_OUT_OF_MEMORY in case of a memory allocation failure;
+ * SP_BPQUEUE_SUCCESS otherwise (i.e. the queue was drained).
+ */
+SP_BPQUEUE_MSG spBPQueueDrainSorted(SPBPQueue source, int* indexes, double* values);
+
+/**
+ * Creates a read-only cursor which visits the elements of a given BPQ
+ * from the minimal element to the maximal one. The cursor neither copies
+ * nor removes elements, and several cursors may visit a queue at once.
+ * Reading the queue does not affect the cursor, but any change to the
+ * queue invalidates it, and it must then only be destroyed.
+ *
+ * @param source - The queue to iterate over.
+ * @return
+ * NULL if given a NULL argument or in case of a memory allocation failure;
+ * A new cursor, positioned before the minimal element, otherwise.
+ */
+SPBPQueueCursor spBPQueueCursorCreate(SPBPQueue source);
+
+/**
+ * Advances a cursor and returns the element it reaches.
+ * The returned element is owned by the queue: it must not be destroyed or
+ * modified, and it is valid only until the queue is changed.
+ *
+ * @param cursor - The cursor to advance.
+ * @return
+ * NULL if given a NULL argument or if all elements were visited;
+ * The next element otherwise.
+ */
+SPListElement spBPQueueCursorNext(SPBPQueueCursor cursor);
+
+/**
+ * Frees all memory allocations associated with a cursor. The queue
+ * itself is not affected. Does nothing if given a NULL argument.
+ *
+ * @param cursor - The cursor to be destroyed.
+ */
+void spBPQueueCursorDestroy(SPBPQueueCursor cursor);
+
 #endif
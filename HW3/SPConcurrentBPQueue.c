@@ -0,0 +1,145 @@
+#include "SPConcurrentBPQueue.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <pthread.h>
+
+struct sp_concurrent_bp_queue_t {
+	SPBPQueue queue;
+	pthread_mutex_t lock;
+	uint64_t threshold;		// Bit pattern of the published k-th value
+};
+
+static uint64_t doubleToBits(double value) {
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+static double bitsToDouble(uint64_t bits) {
+	double value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+/*
+ * Publishes the bound of the underlying queue. Must be called while
+ * holding the queue's lock.
+ */
+static void publishThreshold(SPConcurrentBPQueue source) {
+	double threshold = INFINITY;
+	if (spBPQueueIsFull(source->queue)) {
+		threshold = spBPQueueMaxValue(source->queue);
+	}
+	__atomic_store_n(&source->threshold, doubleToBits(threshold),
+			__ATOMIC_RELEASE);
+}
+
+SPConcurrentBPQueue spConcurrentBPQueueCreate(int maxSize) {
+	SPConcurrentBPQueue this;
+	if (maxSize < 1) {								// Invalid Size Bound
+		return NULL;
+	}
+	this = (SPConcurrentBPQueue) malloc(sizeof(struct sp_concurrent_bp_queue_t));
+	if (!this) {									// Allocation failure
+		return NULL;
+	}
+	// Heap-backed so the critical section is O(log k)
+	this->queue = spBPQueueCreateWithBackend(maxSize, SP_BPQUEUE_MINMAX_HEAP_BACKEND);
+	if (!this->queue) {								// Allocation failure
+		free(this);
+		return NULL;
+	}
+	if (pthread_mutex_init(&this->lock, NULL) != 0) {
+		spBPQueueDestroy(this->queue);
+		free(this);
+		return NULL;
+	}
+	this->threshold = doubleToBits(INFINITY);
+	return this;
+}
+
+void spConcurrentBPQueueDestroy(SPConcurrentBPQueue source) {
+	if (!source) {									// NULL input
+		return;
+	}
+	pthread_mutex_destroy(&source->lock);
+	spBPQueueDestroy(source->queue);
+	free(source);
+}
+
+void spConcurrentBPQueueClear(SPConcurrentBPQueue source) {
+	if (!source) {									// NULL input
+		return;
+	}
+	pthread_mutex_lock(&source->lock);
+	spBPQueueClear(source->queue);
+	publishThreshold(source);
+	pthread_mutex_unlock(&source->lock);
+}
+
+int spConcurrentBPQueueSize(SPConcurrentBPQueue source) {
+	int size;
+	if (!source) {									// Invalid input
+		return -1;
+	}
+	pthread_mutex_lock(&source->lock);
+	size = spBPQueueSize(source->queue);
+	pthread_mutex_unlock(&source->lock);
+	return size;
+}
+
+int spConcurrentBPQueueGetMaxSize(SPConcurrentBPQueue source) {
+	if (!source) {									// Invalid input
+		return -1;
+	}
+	return spBPQueueGetMaxSize(source->queue);		// Never changes
+}
+
+double spConcurrentBPQueueThreshold(SPConcurrentBPQueue source) {
+	if (!source) {									// Invalid input
+		return -1;
+	}
+	return bitsToDouble(__atomic_load_n(&source->threshold, __ATOMIC_ACQUIRE));
+}
+
+SP_BPQUEUE_MSG spConcurrentBPQueueEnqueue(SPConcurrentBPQueue source,
+		SPListElement element) {
+	SP_BPQUEUE_MSG msg;
+	if (!source || !element) {						// Invalid input
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	// Fast rejection. Equal values may still win on the index, so only
+	// strictly greater values are rejected without the lock.
+	if (spListElementGetValue(element) > spConcurrentBPQueueThreshold(source)) {
+		return SP_BPQUEUE_FULL;
+	}
+	pthread_mutex_lock(&source->lock);
+	msg = spBPQueueEnqueue(source->queue, element);
+	if (msg == SP_BPQUEUE_SUCCESS) {
+		publishThreshold(source);
+	}
+	pthread_mutex_unlock(&source->lock);
+	return msg;
+}
+
+SP_BPQUEUE_MSG spConcurrentBPQueueOffer(SPConcurrentBPQueue source,
+		int index, double value) {
+	SPListElementValue element = spListElementValueCreate(index, value);
+	if (!source || index < 0 || value < 0.0) {		// Invalid input
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	return spConcurrentBPQueueEnqueue(source, &element);	// No allocation
+}
+
+SPBPQueue spConcurrentBPQueueSnapshot(SPConcurrentBPQueue source) {
+	SPBPQueue copy;
+	if (!source) {									// Invalid input
+		return NULL;
+	}
+	pthread_mutex_lock(&source->lock);
+	copy = spBPQueueCopy(source->queue);
+	pthread_mutex_unlock(&source->lock);
+	return copy;
+}
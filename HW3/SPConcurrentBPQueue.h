@@ -0,0 +1,141 @@
+#ifndef SPCONCURRENTBPQUEUE_H_
+#define SPCONCURRENTBPQUEUE_H_
+#include "SPBPriorityQueue.h"
+#include "SPListElement.h"
+/**
+ * Concurrent Bounded Priority-Queue Summary
+ *
+ * A thread-safe wrapper around SPBPQueue which many threads may feed at
+ * the same time. The value of the current maximal (k-th) element of a full
+ * queue is published atomically as the queue's threshold, so candidates
+ * which cannot enter the queue are rejected without taking any lock.
+ * Accepted candidates are inserted inside a short critical section.
+ *
+ * Workers may read the threshold before computing a candidate's value and
+ * prune against the global bound instead of their own local one.
+ *
+ * The following functions are available:
+ *
+ *   spConcurrentBPQueueCreate		- Creates a new empty concurrent BPQ.
+ *   spConcurrentBPQueueDestroy		- Frees all memory allocations associated with the queue.
+ *   spConcurrentBPQueueClear		- Clears all elements from the queue.
+ *   spConcurrentBPQueueSize		- Returns the current number of elements.
+ *   spConcurrentBPQueueGetMaxSize	- Returns the queue's size bound.
+ *   spConcurrentBPQueueThreshold	- Returns the currently published k-th value.
+ *   spConcurrentBPQueueEnqueue		- Inserts a new element into the queue.
+ *   spConcurrentBPQueueOffer		- Inserts an (index, value) pair into the queue.
+ *   spConcurrentBPQueueSnapshot	- Returns a copy of the queue's current contents.
+ */
+
+/** type used to define a concurrent bounded priority queue **/
+typedef struct sp_concurrent_bp_queue_t* SPConcurrentBPQueue;
+
+/**
+ * Creates a new concurrent BPQ with the given size bound.
+ *
+ * @param maxSize - The size bound of the queue.
+ * @return
+ * NULL in case of a memory allocation failure or if the input bound is less than 1;
+ * The new queue otherwise.
+ */
+SPConcurrentBPQueue spConcurrentBPQueueCreate(int maxSize);
+
+/**
+ * Frees all memory allocations associated with the queue.
+ * Does nothing if given a NULL argument. The queue must not be in use
+ * by any other thread.
+ *
+ * @param source - The queue to be destroyed.
+ */
+void spConcurrentBPQueueDestroy(SPConcurrentBPQueue source);
+
+/**
+ * Clears the queue of all its elements and resets its threshold.
+ * Does nothing if given a NULL argument.
+ *
+ * @param source - The queue to be cleared.
+ */
+void spConcurrentBPQueueClear(SPConcurrentBPQueue source);
+
+/**
+ * Returns the number of elements of the queue.
+ *
+ * @param source - The query queue.
+ * @return
+ * -1 if given a NULL argument;
+ * The queue size otherwise.
+ */
+int spConcurrentBPQueueSize(SPConcurrentBPQueue source);
+
+/**
+ * Returns the size bound of the queue.
+ *
+ * @param source - The query queue.
+ * @return
+ * -1 if given a NULL argument;
+ * The queue size bound otherwise.
+ */
+int spConcurrentBPQueueGetMaxSize(SPConcurrentBPQueue source);
+
+/**
+ * Returns the currently published threshold of the queue without locking.
+ * While the queue is not full the threshold is positive infinity (every
+ * element is accepted), afterwards it is the value of the maximal element.
+ * An element whose value is strictly greater than the threshold will never
+ * be inserted. The returned value may be stale, but it never drops below
+ * the true bound of the queue.
+ *
+ * @param source - The query queue.
+ * @return
+ * -1 if given a NULL argument;
+ * The current threshold otherwise.
+ */
+double spConcurrentBPQueueThreshold(SPConcurrentBPQueue source);
+
+/**
+ * Inserts a new element to the queue. Follows the semantics of
+ * spBPQueueEnqueue. Elements whose value exceeds the published threshold
+ * are rejected without locking.
+ *
+ * @param source - The input queue.
+ * @param element - The new element to insert.
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if given NULL arguments;
+ * SP_BPQUEUE_OUT_OF_MEMORY in case of a memory allocation failure;
+ * SP_BPQUEUE_FULL if the queue is full AND the new element is not
+ *  less than the current maximal element of the queue;
+ * SP_BPQUEUE_SUCCESS otherwise (i.e. the insertion succeeded).
+ */
+SP_BPQUEUE_MSG spConcurrentBPQueueEnqueue(SPConcurrentBPQueue source, SPListElement element);
+
+/**
+ * Inserts a new element with the given index and value to the queue.
+ * Same as spConcurrentBPQueueEnqueue, but no element is allocated when
+ * the candidate is rejected by the threshold.
+ *
+ * @param source - The input queue.
+ * @param index - The index of the new element (index >= 0).
+ * @param value - The value of the new element (value >= 0.0).
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if source is NULL or index/value are negative;
+ * SP_BPQUEUE_OUT_OF_MEMORY in case of a memory allocation failure;
+ * SP_BPQUEUE_FULL if the queue is full AND the new element is not
+ *  less than the current maximal element of the queue;
+ * SP_BPQUEUE_SUCCESS otherwise (i.e. the insertion succeeded).
+ */
+SP_BPQUEUE_MSG spConcurrentBPQueueOffer(SPConcurrentBPQueue source, int index, double value);
+
+/**
+ * Returns a copy of the current contents of the queue as a regular BPQ.
+ * The copy takes O(1) and shares its elements with the queue until the
+ * queue changes (see spBPQueueCopy), so snapshots can be published often.
+ * It is the responsibility of the caller to destroy the returned queue.
+ *
+ * @param source - The query queue.
+ * @return
+ * NULL if given a NULL argument or in case of a memory allocation failure;
+ * A new BPQ holding the elements of the queue otherwise.
+ */
+SPBPQueue spConcurrentBPQueueSnapshot(SPConcurrentBPQueue source);
+
+#endif
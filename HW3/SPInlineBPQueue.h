@@ -0,0 +1,242 @@
+#ifndef SPINLINEBPQUEUE_H_
+#define SPINLINEBPQUEUE_H_
+#include "SPBPriorityQueue.h"
+#include "SPListElement.h"
+#include "SPPackedElement.h"
+#include <stdbool.h>
+#include <string.h>
+/**
+ * Inline Bounded Priority-Queue Summary
+ *
+ * Header-only bounded priority queues whose capacity is fixed at compile
+ * time. The elements are stored inside the queue struct itself, so a
+ * queue can live on the stack or inside another struct and never
+ * allocates memory. Elements are ordered as in spListElementCompare and
+ * kept sorted; an insertion computes its position and shifts the larger
+ * elements with fixed-length, branch-free loops which the compiler unrolls.
+ *
+ * SP_INLINE_BPQUEUE_DEFINE(N) generates the type SPInlineBPQueue<N> and the
+ * functions below for capacity N. The capacities 1, 4, 8 and 16 are
+ * defined by this header. For example, for N = 4:
+ *
+ *   spInlineBPQueue4Init		- Initializes an empty queue.
+ *   spInlineBPQueue4Size		- Returns the current number of elements.
+ *   spInlineBPQueue4IsEmpty	- Decides whether the queue is empty.
+ *   spInlineBPQueue4IsFull		- Decides whether the queue is full.
+ *   spInlineBPQueue4Enqueue	- Inserts an (index, value) pair into the queue.
+ *   spInlineBPQueue4Dequeue	- Removes the minimal element.
+ *   spInlineBPQueue4Peek		- Returns the minimal element's index and value.
+ *   spInlineBPQueue4MinValue	- Returns the minimal value.
+ *   spInlineBPQueue4MaxValue	- Returns the maximal value.
+ *   spInlineBPQueue4ToBPQueue	- Creates an SPBPQueue holding the queue's elements.
+ *   spInlineBPQueue4FromBPQueue	- Fills the queue with the minimal elements of an SPBPQueue.
+ *
+ * The functions follow the semantics of the matching SPBPQueue functions.
+ * The queue must be initialized before any other function is used.
+ *
+ * @code
+ * SPInlineBPQueue4 queue;
+ * spInlineBPQueue4Init(&queue);
+ * spInlineBPQueue4Enqueue(&queue, index, distance);
+ * @endcode
+ *
+ * SP_INLINE_PACKED_BPQUEUE_DEFINE(N) generates SPInlinePackedBPQueue<N>,
+ * which holds packed elements (see SPPackedElement.h) and so keeps values in
+ * float precision only. It takes half the memory, and ordering its elements
+ * takes a single integer comparison. It offers the functions above except
+ * for the conversions from and to SPBPQueue, e.g. spInlinePackedBPQueue4Init,
+ * and its Enqueue and Peek functions take and return packed elements. The
+ * capacities 4, 8 and 16 are defined by this header.
+ */
+
+#define SP_INLINE_BPQUEUE_DEFINE(N) \
+\
+typedef struct sp_inline_bp_queue_##N##_t { \
+	int size; \
+	int indexes[N]; \
+	double values[N]; \
+} SPInlineBPQueue##N; \
+\
+static inline void spInlineBPQueue##N##Init(SPInlineBPQueue##N* queue) { \
+	memset(queue, 0, sizeof(*queue)); \
+} \
+\
+static inline int spInlineBPQueue##N##Size(const SPInlineBPQueue##N* queue) { \
+	return queue->size; \
+} \
+\
+static inline bool spInlineBPQueue##N##IsEmpty(const SPInlineBPQueue##N* queue) { \
+	return queue->size == 0; \
+} \
+\
+static inline bool spInlineBPQueue##N##IsFull(const SPInlineBPQueue##N* queue) { \
+	return queue->size == (N); \
+} \
+\
+static inline SP_BPQUEUE_MSG spInlineBPQueue##N##Enqueue(SPInlineBPQueue##N* queue, \
+		int index, double value) { \
+	int i, position = 0; \
+	if (index < 0 || value < 0.0) { \
+		return SP_BPQUEUE_INVALID_ARGUMENT; \
+	} \
+	if (queue->size == (N) && !(value < queue->values[(N) - 1] || \
+			(value == queue->values[(N) - 1] && index < queue->indexes[(N) - 1]))) { \
+		return SP_BPQUEUE_FULL; \
+	} \
+	for (i = 0; i < (N); i++) {		/* Count the smaller elements */ \
+		position += (i < queue->size) & ((queue->values[i] < value) | \
+				((queue->values[i] == value) & (queue->indexes[i] < index))); \
+	} \
+	for (i = (N) - 1; i > 0; i--) {	/* Shift the larger elements up */ \
+		queue->values[i] = i > position ? queue->values[i - 1] : queue->values[i]; \
+		queue->indexes[i] = i > position ? queue->indexes[i - 1] : queue->indexes[i]; \
+	} \
+	queue->values[position] = value; \
+	queue->indexes[position] = index; \
+	queue->size += queue->size < (N); \
+	return SP_BPQUEUE_SUCCESS; \
+} \
+\
+static inline SP_BPQUEUE_MSG spInlineBPQueue##N##Dequeue(SPInlineBPQueue##N* queue) { \
+	int i; \
+	if (queue->size == 0) { \
+		return SP_BPQUEUE_EMPTY; \
+	} \
+	for (i = 0; i < (N) - 1; i++) { \
+		queue->values[i] = queue->values[i + 1]; \
+		queue->indexes[i] = queue->indexes[i + 1]; \
+	} \
+	queue->size--; \
+	return SP_BPQUEUE_SUCCESS; \
+} \
+\
+static inline bool spInlineBPQueue##N##Peek(const SPInlineBPQueue##N* queue, \
+		int* index, double* value) { \
+	if (queue->size == 0 || !index || !value) { \
+		return false; \
+	} \
+	*index = queue->indexes[0]; \
+	*value = queue->values[0]; \
+	return true; \
+} \
+\
+static inline double spInlineBPQueue##N##MinValue(const SPInlineBPQueue##N* queue) { \
+	return queue->size == 0 ? -1 : queue->values[0]; \
+} \
+\
+static inline double spInlineBPQueue##N##MaxValue(const SPInlineBPQueue##N* queue) { \
+	return queue->size == 0 ? -1 : queue->values[queue->size - 1]; \
+} \
+\
+static inline SPBPQueue spInlineBPQueue##N##ToBPQueue(const SPInlineBPQueue##N* queue) { \
+	return spBPQueueBuildFromArray((N), queue->indexes, queue->values, queue->size); \
+} \
+\
+static inline bool spInlineBPQueue##N##FromBPQueue(SPInlineBPQueue##N* queue, \
+		SPBPQueue source) { \
+	SPBPQueueCursor cursor; \
+	SPListElement element; \
+	if (!source || !(cursor = spBPQueueCursorCreate(source))) { \
+		return false; \
+	} \
+	spInlineBPQueue##N##Init(queue); \
+	while (queue->size < (N) && (element = spBPQueueCursorNext(cursor)) != NULL) { \
+		queue->indexes[queue->size] = spListElementGetIndex(element); \
+		queue->values[queue->size] = spListElementGetValue(element); \
+		queue->size++; \
+	} \
+	spBPQueueCursorDestroy(cursor); \
+	return true; \
+}
+
+#define SP_INLINE_PACKED_BPQUEUE_DEFINE(N) \
+\
+typedef struct sp_inline_packed_bp_queue_##N##_t { \
+	int size; \
+	SPPackedElement elements[N];	/* Unused slots hold SP_PACKED_ELEMENT_MAX */ \
+} SPInlinePackedBPQueue##N; \
+\
+static inline void spInlinePackedBPQueue##N##Init(SPInlinePackedBPQueue##N* queue) { \
+	int i; \
+	queue->size = 0; \
+	for (i = 0; i < (N); i++) { \
+		queue->elements[i] = SP_PACKED_ELEMENT_MAX; \
+	} \
+} \
+\
+static inline int spInlinePackedBPQueue##N##Size(const SPInlinePackedBPQueue##N* queue) { \
+	return queue->size; \
+} \
+\
+static inline bool spInlinePackedBPQueue##N##IsEmpty(const SPInlinePackedBPQueue##N* queue) { \
+	return queue->size == 0; \
+} \
+\
+static inline bool spInlinePackedBPQueue##N##IsFull(const SPInlinePackedBPQueue##N* queue) { \
+	return queue->size == (N); \
+} \
+\
+static inline SP_BPQUEUE_MSG spInlinePackedBPQueue##N##Enqueue( \
+		SPInlinePackedBPQueue##N* queue, SPPackedElement element) { \
+	int i, position = 0; \
+	if (element == SP_PACKED_ELEMENT_MAX) { \
+		return SP_BPQUEUE_INVALID_ARGUMENT; \
+	} \
+	if (element >= queue->elements[(N) - 1]) { /* Unused slots are greater */ \
+		return SP_BPQUEUE_FULL; \
+	} \
+	for (i = 0; i < (N); i++) {		/* Count the smaller elements */ \
+		position += queue->elements[i] < element; \
+	} \
+	for (i = (N) - 1; i > 0; i--) {	/* Shift the larger elements up */ \
+		queue->elements[i] = i > position ? queue->elements[i - 1] : queue->elements[i]; \
+	} \
+	queue->elements[position] = element; \
+	queue->size += queue->size < (N); \
+	return SP_BPQUEUE_SUCCESS; \
+} \
+\
+static inline SP_BPQUEUE_MSG spInlinePackedBPQueue##N##Dequeue( \
+		SPInlinePackedBPQueue##N* queue) { \
+	int i; \
+	if (queue->size == 0) { \
+		return SP_BPQUEUE_EMPTY; \
+	} \
+	for (i = 0; i < (N) - 1; i++) { \
+		queue->elements[i] = queue->elements[i + 1]; \
+	} \
+	queue->elements[(N) - 1] = SP_PACKED_ELEMENT_MAX; \
+	queue->size--; \
+	return SP_BPQUEUE_SUCCESS; \
+} \
+\
+static inline bool spInlinePackedBPQueue##N##Peek(const SPInlinePackedBPQueue##N* queue, \
+		SPPackedElement* element) { \
+	if (queue->size == 0 || !element) { \
+		return false; \
+	} \
+	*element = queue->elements[0]; \
+	return true; \
+} \
+\
+static inline double spInlinePackedBPQueue##N##MinValue( \
+		const SPInlinePackedBPQueue##N* queue) { \
+	return queue->size == 0 ? -1 : spPackedElementGetValue(queue->elements[0]); \
+} \
+\
+static inline double spInlinePackedBPQueue##N##MaxValue( \
+		const SPInlinePackedBPQueue##N* queue) { \
+	return queue->size == 0 ? -1 : \
+			spPackedElementGetValue(queue->elements[queue->size - 1]); \
+}
+
+SP_INLINE_BPQUEUE_DEFINE(1)
+SP_INLINE_BPQUEUE_DEFINE(4)
+SP_INLINE_BPQUEUE_DEFINE(8)
+SP_INLINE_BPQUEUE_DEFINE(16)
+
+SP_INLINE_PACKED_BPQUEUE_DEFINE(4)
+SP_INLINE_PACKED_BPQUEUE_DEFINE(8)
+SP_INLINE_PACKED_BPQUEUE_DEFINE(16)
+
+#endif /* SPINLINEBPQUEUE_H_ */
@@ -0,0 +1,306 @@
+#include "SPKeyedBPQueue.h"
+#include <stdlib.h>
+#include <assert.h>
+#include <stdint.h>
+#include <limits.h>
+
+#define EMPTY_KEY -1
+
+/** A heap entry, which also records its slot in the index map **/
+typedef struct sp_keyed_entry_t {
+	SPListElementValue data;
+	int slot;
+} KeyedEntry;
+
+struct sp_keyed_bp_queue_t {
+	int maxSize;
+	int size;
+	KeyedEntry* heap;	// Max-heap ordered by spListElementValueCompare
+	int* keys;			// Open-addressing map: the index held by each slot
+	int* positions;		// The heap position of the index held by each slot
+	unsigned int mask;	// Map capacity minus one (capacity is a power of 2)
+	unsigned int shift;	// 32 minus log2 of the map capacity
+};
+
+/*
+ * Fibonacci hashing: the high bits of the product depend on all the bits of
+ * the index, so strided indexes do not share home slots.
+ */
+static unsigned int mapHome(SPKeyedBPQueue source, int index) {
+	return (unsigned int) (((uint32_t) index * 2654435761u) >> source->shift);
+}
+
+static int mapFind(SPKeyedBPQueue source, int index) {
+	unsigned int slot = mapHome(source, index);
+	while (source->keys[slot] != EMPTY_KEY) {
+		if (source->keys[slot] == index) {
+			return (int) slot;
+		}
+		slot = (slot + 1) & source->mask;
+	}
+	return -1;
+}
+
+/*
+ * Claims a slot for an index which is not in the map. The map is always
+ * at most half full, so an empty slot exists.
+ */
+static int mapInsert(SPKeyedBPQueue source, int index) {
+	unsigned int slot = mapHome(source, index);
+	while (source->keys[slot] != EMPTY_KEY) {
+		slot = (slot + 1) & source->mask;
+	}
+	source->keys[slot] = index;
+	return (int) slot;
+}
+
+/*
+ * Frees a slot using backward-shift deletion, so no tombstones are needed.
+ * Heap entries whose slot moved are updated.
+ */
+static void mapRemove(SPKeyedBPQueue source, int slot) {
+	unsigned int hole = (unsigned int) slot;
+	unsigned int next = hole;
+	unsigned int home;
+	while (true) {
+		next = (next + 1) & source->mask;
+		if (source->keys[next] == EMPTY_KEY) {
+			break;
+		}
+		home = mapHome(source, source->keys[next]);
+		// Move the entry back only if the hole lies on its probe path
+		if (((next - home) & source->mask) >= ((next - hole) & source->mask)) {
+			source->keys[hole] = source->keys[next];
+			source->positions[hole] = source->positions[next];
+			source->heap[source->positions[hole]].slot = (int) hole;
+			hole = next;
+		}
+	}
+	source->keys[hole] = EMPTY_KEY;
+}
+
+static void heapPlace(SPKeyedBPQueue source, int position, KeyedEntry entry) {
+	source->heap[position] = entry;
+	source->positions[entry.slot] = position;
+}
+
+static void heapSiftUp(SPKeyedBPQueue source, int position) {
+	KeyedEntry entry = source->heap[position];
+	int parent;
+	while (position > 0) {
+		parent = (position - 1) / 2;
+		if (spListElementValueCompare(source->heap[parent].data, entry.data) >= 0) {
+			break;
+		}
+		heapPlace(source, position, source->heap[parent]);
+		position = parent;
+	}
+	heapPlace(source, position, entry);
+}
+
+static void heapSiftDown(SPKeyedBPQueue source, int position) {
+	KeyedEntry entry = source->heap[position];
+	int child;
+	while ((child = 2 * position + 1) < source->size) {
+		if (child + 1 < source->size &&
+				spListElementValueCompare(source->heap[child + 1].data,
+						source->heap[child].data) > 0) {
+			child++;
+		}
+		if (spListElementValueCompare(source->heap[child].data, entry.data) <= 0) {
+			break;
+		}
+		heapPlace(source, position, source->heap[child]);
+		position = child;
+	}
+	heapPlace(source, position, entry);
+}
+
+SPKeyedBPQueue spKeyedBPQueueCreate(int maxSize) {
+	SPKeyedBPQueue this;
+	unsigned int capacity = 2;
+	unsigned int shift = 31;
+	if (maxSize < 1 || maxSize > INT_MAX / 2) {	// Invalid Size Bound, or a map too large
+		return NULL;
+	}
+	while (capacity < 2 * (unsigned int) maxSize) {	// Keep the load factor <= 1/2
+		capacity *= 2;
+		shift--;
+	}
+	this = (SPKeyedBPQueue) malloc(sizeof(struct sp_keyed_bp_queue_t));
+	if (!this) {									// Allocation failure
+		return NULL;
+	}
+	this->heap = (KeyedEntry*) malloc(sizeof(KeyedEntry) * maxSize);
+	this->keys = (int*) malloc(sizeof(int) * capacity);
+	this->positions = (int*) malloc(sizeof(int) * capacity);
+	if (!this->heap || !this->keys || !this->positions) {
+		spKeyedBPQueueDestroy(this);
+		return NULL;
+	}
+	this->maxSize = maxSize;
+	this->mask = capacity - 1;
+	this->shift = shift;
+	this->size = 0;
+	spKeyedBPQueueClear(this);
+	return this;
+}
+
+void spKeyedBPQueueDestroy(SPKeyedBPQueue source) {
+	if (!source) {									// NULL input
+		return;
+	}
+	free(source->heap);
+	free(source->keys);
+	free(source->positions);
+	free(source);
+}
+
+void spKeyedBPQueueClear(SPKeyedBPQueue source) {
+	unsigned int slot;
+	if (!source) {									// NULL input
+		return;
+	}
+	for (slot = 0; slot <= source->mask; slot++) {
+		source->keys[slot] = EMPTY_KEY;
+	}
+	source->size = 0;
+}
+
+int spKeyedBPQueueSize(SPKeyedBPQueue source) {
+	if (!source) {									// Invalid input
+		return -1;
+	}
+	return source->size;
+}
+
+int spKeyedBPQueueGetMaxSize(SPKeyedBPQueue source) {
+	if (!source) {									// Invalid input
+		return -1;
+	}
+	return source->maxSize;
+}
+
+SP_KEYED_BPQUEUE_MSG spKeyedBPQueueEnqueue(SPKeyedBPQueue source, int index, double value) {
+	KeyedEntry input;
+	int slot, position;
+	if (!source || index < 0 || value < 0.0) {		// Invalid input
+		return SP_KEYED_BPQUEUE_INVALID_ARGUMENT;
+	}
+
+	slot = mapFind(source, index);
+	if (slot >= 0) {								// Decrease key
+		position = source->positions[slot];
+		if (value >= source->heap[position].data.value) {
+			return SP_KEYED_BPQUEUE_NOT_IMPROVED;
+		}
+		source->heap[position].data.value = value;
+		heapSiftDown(source, position);
+		return SP_KEYED_BPQUEUE_SUCCESS;
+	}
+
+	input.data = spListElementValueCreate(index, value);
+	if (source->size < source->maxSize) {			// Room left, plain insert
+		input.slot = mapInsert(source, index);
+		heapPlace(source, source->size, input);
+		source->size++;
+		heapSiftUp(source, source->size - 1);
+		return SP_KEYED_BPQUEUE_SUCCESS;
+	}
+
+	if (spListElementValueCompare(input.data, source->heap[0].data) >= 0) {	// Not less than the maximum
+		return SP_KEYED_BPQUEUE_FULL;
+	}
+	mapRemove(source, source->heap[0].slot);		// Evict the maximum
+	input.slot = mapInsert(source, index);
+	heapPlace(source, 0, input);
+	heapSiftDown(source, 0);
+	return SP_KEYED_BPQUEUE_SUCCESS;
+}
+
+SP_KEYED_BPQUEUE_MSG spKeyedBPQueueRemove(SPKeyedBPQueue source, int index) {
+	KeyedEntry last;
+	int slot, position;
+	if (!source || index < 0) {						// Invalid input
+		return SP_KEYED_BPQUEUE_INVALID_ARGUMENT;
+	}
+	slot = mapFind(source, index);
+	if (slot < 0) {
+		return SP_KEYED_BPQUEUE_NOT_FOUND;
+	}
+	position = source->positions[slot];
+	mapRemove(source, slot);
+	source->size--;
+	if (position != source->size) {					// Fill the hole with the last entry
+		last = source->heap[source->size];
+		heapPlace(source, position, last);
+		heapSiftUp(source, position);
+		heapSiftDown(source, source->positions[last.slot]);
+	}
+	return SP_KEYED_BPQUEUE_SUCCESS;
+}
+
+bool spKeyedBPQueueContains(SPKeyedBPQueue source, int index) {
+	if (!source || index < 0) {						// Invalid input
+		return false;
+	}
+	return mapFind(source, index) >= 0;
+}
+
+double spKeyedBPQueueGetValue(SPKeyedBPQueue source, int index) {
+	int slot;
+	if (!source || index < 0) {						// Invalid input
+		return -1;
+	}
+	slot = mapFind(source, index);
+	if (slot < 0) {
+		return -1;
+	}
+	return source->heap[source->positions[slot]].data.value;
+}
+
+SPListElement spKeyedBPQueuePeekLast(SPKeyedBPQueue source) {
+	if (!source || spKeyedBPQueueIsEmpty(source)) {
+		return NULL;
+	}
+	return spListElementCreateFromValue(source->heap[0].data);
+}
+
+double spKeyedBPQueueMaxValue(SPKeyedBPQueue source) {
+	if (!source || spKeyedBPQueueIsEmpty(source)) {
+		return -1;
+	}
+	return source->heap[0].data.value;
+}
+
+SP_KEYED_BPQUEUE_MSG spKeyedBPQueueDrainSorted(SPKeyedBPQueue source, int* indexes, double* values) {
+	KeyedEntry maximum;
+	int i, count;
+	if (!source || !indexes || !values) {			// Invalid input
+		return SP_KEYED_BPQUEUE_INVALID_ARGUMENT;
+	}
+	count = source->size;
+	while (source->size > 1) {						// In-place heap sort, ascending
+		maximum = source->heap[0];
+		source->size--;
+		source->heap[0] = source->heap[source->size];
+		heapSiftDown(source, 0);
+		source->heap[source->size] = maximum;
+	}
+	for (i = 0; i < count; i++) {
+		indexes[i] = source->heap[i].data.index;
+		values[i] = source->heap[i].data.value;
+	}
+	spKeyedBPQueueClear(source);
+	return SP_KEYED_BPQUEUE_SUCCESS;
+}
+
+bool spKeyedBPQueueIsEmpty(SPKeyedBPQueue source) {
+	assert(source != NULL);
+	return source->size == 0;
+}
+
+bool spKeyedBPQueueIsFull(SPKeyedBPQueue source) {
+	assert(source != NULL);
+	return source->size == source->maxSize;
+}
@@ -0,0 +1,207 @@
+#ifndef SPKEYEDBPQUEUE_H_
+#define SPKEYEDBPQUEUE_H_
+#include "SPListElement.h"
+#include <stdbool.h>
+/**
+ * Keyed Bounded Priority-Queue Summary
+ *
+ * A bounded priority queue which holds at most one element per index.
+ * Like SPBPQueue it keeps the elements which are minimal with respect to
+ * spListElementCompare, but inserting an index which is already in the
+ * queue updates its value instead of adding a duplicate.
+ *
+ * The queue is implemented as a binary max-heap together with an
+ * open-addressing map from an index to its slot in the heap, so an
+ * insertion, a value update and a removal by index all take O(log k).
+ *
+ * The following functions are available:
+ *
+ *   spKeyedBPQueueCreate		- Creates a new empty keyed BPQ.
+ *   spKeyedBPQueueDestroy		- Frees all memory allocations associated with a keyed BPQ.
+ *   spKeyedBPQueueClear		- Clears all elements from a keyed BPQ.
+ *   spKeyedBPQueueSize			- Returns the current number of elements.
+ *   spKeyedBPQueueGetMaxSize	- Returns a keyed BPQ's size bound.
+ *   spKeyedBPQueueEnqueue		- Inserts an index or decreases its value.
+ *   spKeyedBPQueueRemove		- Removes the element with a given index.
+ *   spKeyedBPQueueContains		- Decides whether an index is in a keyed BPQ.
+ *   spKeyedBPQueueGetValue		- Returns the value stored for an index.
+ *   spKeyedBPQueuePeekLast		- Returns the element whose value is maximal.
+ *   spKeyedBPQueueMaxValue		- Returns the keyed BPQ's maximal value.
+ *   spKeyedBPQueueDrainSorted	- Moves all elements of a keyed BPQ into arrays, in order.
+ *   spKeyedBPQueueIsEmpty		- Decides whether a keyed BPQ is empty.
+ *   spKeyedBPQueueIsFull		- Decides whether a keyed BPQ is full.
+ */
+
+/** type used to define a keyed bounded priority queue **/
+typedef struct sp_keyed_bp_queue_t* SPKeyedBPQueue;
+
+/** type for error reporting **/
+typedef enum sp_keyed_bp_queue_msg_t {
+	SP_KEYED_BPQUEUE_OUT_OF_MEMORY,
+	SP_KEYED_BPQUEUE_FULL,
+	SP_KEYED_BPQUEUE_EMPTY,
+	SP_KEYED_BPQUEUE_INVALID_ARGUMENT,
+	SP_KEYED_BPQUEUE_NOT_FOUND,
+	SP_KEYED_BPQUEUE_NOT_IMPROVED,
+	SP_KEYED_BPQUEUE_SUCCESS
+} SP_KEYED_BPQUEUE_MSG;
+
+/**
+ * Creates a new keyed BPQ with the given size bound.
+ *
+ * @param maxSize - The size bound of the queue.
+ * @return
+ * NULL in case of a memory allocation failure or if the input bound is less than 1
+ *  or greater than INT_MAX / 2;
+ * The new keyed BPQ otherwise.
+ */
+SPKeyedBPQueue spKeyedBPQueueCreate(int maxSize);
+
+/**
+ * Frees all memory allocations associated with a keyed BPQ.
+ * Does nothing if given a NULL argument.
+ *
+ * @param source - The queue to be destroyed.
+ */
+void spKeyedBPQueueDestroy(SPKeyedBPQueue source);
+
+/**
+ * Clears a keyed BPQ of all its elements.
+ * Does nothing if given a NULL argument.
+ *
+ * @param source - The queue to be cleared.
+ */
+void spKeyedBPQueueClear(SPKeyedBPQueue source);
+
+/**
+ * Returns the number of elements of a given keyed BPQ.
+ *
+ * @param source - The query queue.
+ * @return
+ * -1 if given a NULL argument;
+ * The queue size otherwise.
+ */
+int spKeyedBPQueueSize(SPKeyedBPQueue source);
+
+/**
+ * Returns the size bound of a given keyed BPQ.
+ *
+ * @param source - The query queue.
+ * @return
+ * -1 if given a NULL argument;
+ * The queue size bound otherwise.
+ */
+int spKeyedBPQueueGetMaxSize(SPKeyedBPQueue source);
+
+/**
+ * Inserts the element (index, value) to a given keyed BPQ, or decreases
+ * the value of index if it is already in the queue.
+ * If index is not in the queue and the queue is at full capacity, the
+ * element is inserted only if it is less than the current maximal element,
+ * which is then removed from the queue.
+ *
+ * @param source - The input queue.
+ * @param index - The index of the element (index >= 0).
+ * @param value - The value of the element (value >= 0.0).
+ * @return
+ * SP_KEYED_BPQUEUE_INVALID_ARGUMENT if source is NULL or index/value are negative;
+ * SP_KEYED_BPQUEUE_NOT_IMPROVED if index is in the queue with a value
+ *  less than or equal to the given value (the queue is not changed);
+ * SP_KEYED_BPQUEUE_FULL if index is not in the queue, the queue is full AND
+ *  the new element is not less than the current maximal element;
+ * SP_KEYED_BPQUEUE_SUCCESS otherwise (i.e. the element was inserted or updated).
+ */
+SP_KEYED_BPQUEUE_MSG spKeyedBPQueueEnqueue(SPKeyedBPQueue source, int index, double value);
+
+/**
+ * Removes the element with the given index from a keyed BPQ.
+ *
+ * @param source - The input queue.
+ * @param index - The index of the element to remove.
+ * @return
+ * SP_KEYED_BPQUEUE_INVALID_ARGUMENT if source is NULL or index is negative;
+ * SP_KEYED_BPQUEUE_NOT_FOUND if index is not in the queue;
+ * SP_KEYED_BPQUEUE_SUCCESS otherwise (i.e. the removal succeeded).
+ */
+SP_KEYED_BPQUEUE_MSG spKeyedBPQueueRemove(SPKeyedBPQueue source, int index);
+
+/**
+ * Decides whether the given index is in a keyed BPQ.
+ *
+ * @param source - The query queue.
+ * @param index - The query index.
+ * @return
+ * False if source is NULL or if index is not in the queue;
+ * True otherwise.
+ */
+bool spKeyedBPQueueContains(SPKeyedBPQueue source, int index);
+
+/**
+ * Returns the value stored for the given index in a keyed BPQ.
+ *
+ * @param source - The query queue.
+ * @param index - The query index.
+ * @return
+ * -1 if source is NULL or if index is not in the queue;
+ * The value of index otherwise.
+ */
+double spKeyedBPQueueGetValue(SPKeyedBPQueue source, int index);
+
+/**
+ * Returns the maximal element of a given keyed BPQ.
+ *
+ * @param source - The query queue.
+ * @return
+ * NULL if given a NULL argument, if the input queue is empty or in
+ * 	case of a memory allocation failure;
+ * A copy of the maximal element otherwise.
+ */
+SPListElement spKeyedBPQueuePeekLast(SPKeyedBPQueue source);
+
+/**
+ * Returns the maximal value of a given keyed BPQ.
+ *
+ * @param source - The query queue.
+ * @return
+ * -1 if given a NULL argument or if the input queue is empty;
+ * The maximal value otherwise.
+ */
+double spKeyedBPQueueMaxValue(SPKeyedBPQueue source);
+
+/**
+ * Moves all elements of a given keyed BPQ into the given arrays, from the
+ * minimal element to the maximal one, and leaves the queue empty. The
+ * arrays must be able to hold spKeyedBPQueueSize(source) entries.
+ *
+ * @param source - The input queue.
+ * @param indexes - The array receiving the elements' indexes.
+ * @param values - The array receiving the elements' values.
+ * @return
+ * SP_KEYED_BPQUEUE_INVALID_ARGUMENT if given NULL arguments;
+ * SP_KEYED_BPQUEUE_SUCCESS otherwise (i.e. the queue was drained).
+ */
+SP_KEYED_BPQUEUE_MSG spKeyedBPQueueDrainSorted(SPKeyedBPQueue source, int* indexes, double* values);
+
+/**
+ * Decides whether a given keyed BPQ is empty.
+ *
+ * @param source - The query queue.
+ * @assert source != NULL
+ * @return
+ * True if the input queue is empty;
+ * False otherwise.
+ */
+bool spKeyedBPQueueIsEmpty(SPKeyedBPQueue source);
+
+/**
+ * Decides whether a given keyed BPQ is full.
+ *
+ * @param source - The query queue.
+ * @assert source != NULL
+ * @return
+ * True if the input queue is full;
+ * False otherwise.
+ */
+bool spKeyedBPQueueIsFull(SPKeyedBPQueue source);
+
+#endif
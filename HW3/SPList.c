@@ -1,95 +1,281 @@
 #include "SPList.h"
 #include <stdlib.h>
+#include <assert.h>
 
-typedef struct node_t {
-	SPListElement data;
-	struct node_t* next;
-	struct node_t* previous;
+#define SP_LIST_OWN_POOL_SLAB_SIZE 64
+
+typedef struct sp_list_node_t {
+	SPListElementValue data;	// Stored by value, unused by the sentinels
+	struct sp_list_node_t* next;
+	struct sp_list_node_t* previous;
 }*Node;
-Node createNode(Node previous, Node next, SPListElement element);
-void destroyNode(Node node);
+
+/** A block of nodes allocated at once by a pool **/
+typedef struct sp_list_slab_t {
+	struct sp_list_slab_t* next;
+	struct sp_list_node_t nodes[];
+}*Slab;
+
+struct sp_list_node_pool_t {
+	Node free;			// Released nodes, linked through their next field
+	Slab slabs;
+	int nodesPerSlab;
+};
 
 struct sp_list_t {
 	Node head;
 	Node tail;
 	Node current;
 	int size;
+	SPListNodePool pool;	// NULL if nodes come from malloc
+	bool ownsPool;
 };
 
-Node createNode(Node previous, Node next, SPListElement element) {
-	SPListElement newElement = spListElementCopy(element);
-	if (newElement == NULL) {
+Node allocateNode(SPList list);
+void releaseNode(SPList list, Node node);
+static void releaseChain(SPList list, Node first);
+Node createNode(SPList list, Node previous, Node next, SPListElementValue element);
+void destroyNode(SPList list, Node node);
+
+SPListNodePool spListNodePoolCreate(int nodesPerSlab) {
+	if (nodesPerSlab < 1) {
+		return NULL;
+	}
+	SPListNodePool pool = (SPListNodePool) malloc(sizeof(*pool));
+	if (pool == NULL) {
 		return NULL;
 	}
-	Node newNode = (Node) malloc(sizeof(*newNode));
+	pool->free = NULL;
+	pool->slabs = NULL;
+	pool->nodesPerSlab = nodesPerSlab;
+	return pool;
+}
+
+void spListNodePoolDestroy(SPListNodePool pool) {
+	if (pool == NULL) {
+		return;
+	}
+	while (pool->slabs != NULL) {
+		Slab next = pool->slabs->next;
+		free(pool->slabs);
+		pool->slabs = next;
+	}
+	free(pool);
+}
+
+/*
+ * Takes a node from the list's pool, allocating a new slab when the free
+ * list is empty, or from malloc if the list has no pool.
+ */
+Node allocateNode(SPList list) {
+	SPListNodePool pool = list->pool;
+	if (pool == NULL) {
+		return (Node) malloc(sizeof(struct sp_list_node_t));
+	}
+	if (pool->free == NULL) {
+		Slab slab = (Slab) malloc(sizeof(*slab) +
+				sizeof(struct sp_list_node_t) * pool->nodesPerSlab);
+		if (slab == NULL) {
+			return NULL;
+		}
+		slab->next = pool->slabs;
+		pool->slabs = slab;
+		for (int i = 0; i < pool->nodesPerSlab; i++) {
+			slab->nodes[i].next = pool->free;
+			pool->free = &slab->nodes[i];
+		}
+	}
+	Node node = pool->free;
+	pool->free = node->next;
+	return node;
+}
+
+void releaseNode(SPList list, Node node) {
+	if (list->pool == NULL) {
+		free(node);
+		return;
+	}
+	node->next = list->pool->free;
+	list->pool->free = node;
+}
+
+/*
+ * Allocates n nodes linked through their next fields and returns the first
+ * one. A pooled list reuses free nodes and takes the rest from one new slab
+ * of exactly the missing size. On failure nothing is allocated.
+ */
+static Node allocateChain(SPList list, int n) {
+	SPListNodePool pool = list->pool;
+	Node first = NULL;
+	int taken = 0;
+	if (pool == NULL) {
+		for (; taken < n; taken++) {
+			Node node = (Node) malloc(sizeof(struct sp_list_node_t));
+			if (node == NULL) {
+				releaseChain(list, first);
+				return NULL;
+			}
+			node->next = first;
+			first = node;
+		}
+		return first;
+	}
+	for (; taken < n && pool->free != NULL; taken++) {
+		Node node = pool->free;
+		pool->free = node->next;
+		node->next = first;
+		first = node;
+	}
+	if (taken < n) {
+		Slab slab = (Slab) malloc(sizeof(*slab) + sizeof(struct sp_list_node_t) * (n - taken));
+		if (slab == NULL) {
+			releaseChain(list, first);
+			return NULL;
+		}
+		slab->next = pool->slabs;
+		pool->slabs = slab;
+		for (int i = n - taken - 1; i >= 0; i--) {
+			slab->nodes[i].next = first;
+			first = &slab->nodes[i];
+		}
+	}
+	return first;
+}
+
+/*
+ * Releases nodes linked through their next fields, up to a NULL next.
+ */
+static void releaseChain(SPList list, Node first) {
+	while (first != NULL) {
+		Node next = first->next;
+		releaseNode(list, first);
+		first = next;
+	}
+}
+
+/*
+ * Links the nodes first..last, whose previous and next fields are already
+ * linked between themselves, right after the given node of the list.
+ */
+static void linkChain(SPList list, Node after, Node first, Node last, int count) {
+	first->previous = after;
+	last->next = after->next;
+	after->next->previous = last;
+	after->next = first;
+	list->size += count;
+}
+
+/*
+ * Copies count elements, starting from the given node, into new nodes of
+ * the list linked to each other. Sets last to the last new node and
+ * returns the first one, or NULL on failure. The source is only read.
+ */
+static Node copyChain(SPList list, const struct sp_list_node_t* source, int count,
+		Node* last) {
+	Node first = allocateChain(list, count);
+	if (first == NULL) {
+		return NULL;
+	}
+	Node previous = NULL;
+	for (Node node = first; node != NULL; previous = node, node = node->next) {
+		node->data = source->data;
+		node->previous = previous;
+		source = source->next;
+	}
+	*last = previous;
+	return first;
+}
+
+Node createNode(SPList list, Node previous, Node next, SPListElementValue element) {
+	Node newNode = allocateNode(list);
 	if (newNode == NULL) {
-		spListElementDestroy(newElement);
 		return NULL;
 	}
-	newNode->data = newElement;
+	newNode->data = element;
 	newNode->previous = previous;
 	newNode->next = next;
 	return newNode;
 }
 
-void destroyNode(Node node) {
+void destroyNode(SPList list, Node node) {
 	if (node == NULL) {
 		return;
 	}
-	if (node->data != NULL) {
-		spListElementDestroy(node->data);
-	}
-	free(node);
+	releaseNode(list, node);
 }
 
-SPList spListCreate() {
+/*
+ * Creates an empty list whose nodes come from the given pool (NULL for
+ * malloc). The list takes ownership of the pool if ownsPool is true.
+ */
+static SPList createList(SPListNodePool pool, bool ownsPool) {
 	SPList list = (SPList) malloc(sizeof(*list));
 	if (list == NULL) {
 		return NULL;
-	} else {
-		list->head = (Node) malloc(sizeof(*list->head));
-		if (list->head == NULL) {
-			free(list);
-			return NULL;
-		}
-		list->tail = (Node) malloc(sizeof(*list->tail));
-		if (list->tail == NULL) {
-			free(list->head);
-			free(list);
-			return NULL;
-		}
-		list->head->data = NULL;
-		list->head->next = list->tail;
-		list->head->previous = NULL;
-		list->tail->data = NULL;
-		list->tail->next = NULL;
-		list->tail->previous = list->head;
-		list->current = NULL;
-		list->size = 0;
-		return list;
+	}
+	list->pool = pool;
+	list->ownsPool = ownsPool;
+	list->head = allocateNode(list);
+	if (list->head == NULL) {
+		free(list);
+		return NULL;
+	}
+	list->tail = allocateNode(list);
+	if (list->tail == NULL) {
+		releaseNode(list, list->head);
+		free(list);
+		return NULL;
+	}
+	list->head->next = list->tail;
+	list->head->previous = NULL;
+	list->tail->next = NULL;
+	list->tail->previous = list->head;
+	list->current = NULL;
+	list->size = 0;
+	return list;
+}
+
+SPList spListCreate() {
+	return createList(NULL, false);
+}
 
+SPList spListCreateWithPool(SPListNodePool pool) {
+	if (pool != NULL) {
+		return createList(pool, false);
 	}
+	pool = spListNodePoolCreate(SP_LIST_OWN_POOL_SLAB_SIZE);
+	if (pool == NULL) {
+		return NULL;
+	}
+	SPList list = createList(pool, true);
+	if (list == NULL) {
+		spListNodePoolDestroy(pool);
+	}
+	return list;
 }
 
 SPList spListCopy(SPList list) {
 	if (list == NULL) {
 		return NULL;
 	}
-	SPList copyList = spListCreate();
+	SPList copyList;
+	if (list->pool == NULL) {
+		copyList = spListCreate();
+	} else {
+		copyList = spListCreateWithPool(list->ownsPool ? NULL : list->pool);
+	}
 	if (copyList == NULL) {
 		return NULL;
 	}
-	SPListElement currentElement = spListGetFirst(list);
-	while (currentElement) {
-		if (spListInsertLast(copyList, currentElement) != SP_LIST_SUCCESS) {
+	if (list->size > 0) {							// The source is only read
+		Node last;
+		Node first = copyChain(copyList, list->head->next, list->size, &last);
+		if (first == NULL) {
 			spListDestroy(copyList);
-			list->current = NULL;
 			return NULL;
 		}
-		currentElement = spListGetNext(list);
+		linkChain(copyList, copyList->head, first, last, list->size);
 	}
-	list->current = NULL;
-	copyList->current = NULL;
 	return copyList;
 }
 
@@ -102,7 +288,7 @@ SPListElement spListGetFirst(SPList list) {
 		return NULL;
 	} else {
 		list->current = list->head->next;
-		return list->current->data;
+		return &list->current->data;
 	}
 }
 
@@ -111,7 +297,7 @@ SPListElement spListGetLast(SPList list){
 		return NULL;
 	} else {
 		list->current = list->tail->previous;
-		return list->current->data;
+		return &list->current->data;
 	}
 }
 
@@ -124,7 +310,7 @@ SPListElement spListGetNext(SPList list) {
 			return NULL;
 		} else {
 			list->current = list->current->next;
-			return list->current->data;
+			return &list->current->data;
 		}
 	}
 }
@@ -138,7 +324,7 @@ SPListElement spListGetPrevious(SPList list) {
 			return NULL;
 		} else {
 			list->current = list->current->previous;
-			return list->current->data;
+			return &list->current->data;
 		}
 	}
 }
@@ -147,7 +333,7 @@ SPListElement spListGetCurrent(SPList list) {
 	if (list == NULL || spListGetSize(list) == 0 || list->current == NULL) {
 		return NULL;
 	} else {
-		return list->current->data;
+		return &list->current->data;
 	}
 }
 
@@ -155,7 +341,38 @@ SP_LIST_MSG spListInsertFirst(SPList list, SPListElement element) {
 	if (list == NULL || element == NULL) {
 		return SP_LIST_NULL_ARGUMENT;
 	}
-	Node newNode = createNode(list->head, list->head->next, element);
+	return spListInsertFirstValue(list, *element);
+}
+
+SP_LIST_MSG spListInsertLast(SPList list, SPListElement element) {
+	if (list == NULL || element == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	return spListInsertLastValue(list, *element);
+}
+
+SP_LIST_MSG spListInsertBeforeCurrent(SPList list, SPListElement element) {
+	if (list == NULL || element == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	return spListInsertBeforeCurrentValue(list, *element);
+}
+
+SP_LIST_MSG spListInsertAfterCurrent(SPList list, SPListElement element) {
+	if (list == NULL || element == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	return spListInsertAfterCurrentValue(list, *element);
+}
+
+SP_LIST_MSG spListInsertFirstValue(SPList list, SPListElementValue element) {
+	if (list == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	if (!spListElementValueIsValid(element)) {
+		return SP_LIST_INVALID_ARGUMENT;
+	}
+	Node newNode = createNode(list, list->head, list->head->next, element);
 	if (newNode == NULL) {
 		return SP_LIST_OUT_OF_MEMORY;
 	}
@@ -165,11 +382,14 @@ SP_LIST_MSG spListInsertFirst(SPList list, SPListElement element) {
 	return SP_LIST_SUCCESS;
 }
 
-SP_LIST_MSG spListInsertLast(SPList list, SPListElement element) {
-	if (list == NULL || element == NULL) {
+SP_LIST_MSG spListInsertLastValue(SPList list, SPListElementValue element) {
+	if (list == NULL) {
 		return SP_LIST_NULL_ARGUMENT;
 	}
-	Node newNode = createNode(list->tail->previous, list->tail, element);
+	if (!spListElementValueIsValid(element)) {
+		return SP_LIST_INVALID_ARGUMENT;
+	}
+	Node newNode = createNode(list, list->tail->previous, list->tail, element);
 	if (newNode == NULL) {
 		return SP_LIST_OUT_OF_MEMORY;
 	}
@@ -179,14 +399,17 @@ SP_LIST_MSG spListInsertLast(SPList list, SPListElement element) {
 	return SP_LIST_SUCCESS;
 }
 
-SP_LIST_MSG spListInsertBeforeCurrent(SPList list, SPListElement element) {
-	if (list == NULL || element == NULL) {
+SP_LIST_MSG spListInsertBeforeCurrentValue(SPList list, SPListElementValue element) {
+	if (list == NULL) {
 		return SP_LIST_NULL_ARGUMENT;
 	}
+	if (!spListElementValueIsValid(element)) {
+		return SP_LIST_INVALID_ARGUMENT;
+	}
 	if (list->current == NULL) {
 		return SP_LIST_INVALID_CURRENT;
 	}
-	Node newNode = createNode(list->current->previous, list->current, element);
+	Node newNode = createNode(list, list->current->previous, list->current, element);
 	if (newNode == NULL) {
 		return SP_LIST_OUT_OF_MEMORY;
 	}
@@ -196,21 +419,24 @@ SP_LIST_MSG spListInsertBeforeCurrent(SPList list, SPListElement element) {
 	return SP_LIST_SUCCESS;
 }
 
-SP_LIST_MSG spListInsertAfterCurrent(SPList list, SPListElement element) {
-	if (list == NULL || element == NULL) {
+SP_LIST_MSG spListInsertAfterCurrentValue(SPList list, SPListElementValue element) {
+	if (list == NULL) {
 		return SP_LIST_NULL_ARGUMENT;
 	}
+	if (!spListElementValueIsValid(element)) {
+		return SP_LIST_INVALID_ARGUMENT;
+	}
 	if (list->current == NULL) {
 		return SP_LIST_INVALID_CURRENT;
-	} else if (list->current == list->tail->previous) {
-		return spListInsertLast(list, element);
-	} else {
-		Node tempCurrent = list->current;
-		list->current = list->current->next;
-		SP_LIST_MSG res = spListInsertBeforeCurrent(list, element);
-		list->current = tempCurrent;
-		return res;
 	}
+	Node newNode = createNode(list, list->current, list->current->next, element);
+	if (newNode == NULL) {
+		return SP_LIST_OUT_OF_MEMORY;
+	}
+	list->current->next->previous = newNode;
+	list->current->next = newNode;
+	list->size++;
+	return SP_LIST_SUCCESS;
 }
 
 SP_LIST_MSG spListRemoveCurrent(SPList list) {
@@ -222,19 +448,282 @@ SP_LIST_MSG spListRemoveCurrent(SPList list) {
 	}
 	list->current->previous->next = list->current->next;
 	list->current->next->previous = list->current->previous;
-	destroyNode(list->current);
+	destroyNode(list, list->current);
 	list->current = NULL;
 	list->size--;
 	return SP_LIST_SUCCESS;
 }
 
+SP_LIST_MSG spListAppendArray(SPList list, const int* indexes,
+		const double* values, int n) {
+	if (list == NULL || (n > 0 && (indexes == NULL || values == NULL))) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	if (n <= 0) {
+		return SP_LIST_SUCCESS;
+	}
+	for (int i = 0; i < n; i++) {
+		if (indexes[i] < 0 || values[i] < 0) {
+			return SP_LIST_INVALID_ARGUMENT;
+		}
+	}
+	Node first = allocateChain(list, n);
+	if (first == NULL) {
+		return SP_LIST_OUT_OF_MEMORY;
+	}
+	Node node = first;
+	Node previous = NULL;
+	for (int i = 0; i < n; i++, previous = node, node = node->next) {
+		node->data.index = indexes[i];
+		node->data.value = values[i];
+		node->previous = previous;
+	}
+	linkChain(list, list->tail->previous, first, previous, n);
+	return SP_LIST_SUCCESS;
+}
+
+/*
+ * Moves all nodes of other right after the given node of list. Nodes move
+ * as they are if both lists take their nodes from the same place, and are
+ * copied otherwise.
+ */
+static SP_LIST_MSG moveAfter(SPList list, Node after, SPList other) {
+	if (other->size == 0) {
+		return SP_LIST_SUCCESS;
+	}
+	Node first = other->head->next;
+	Node last = other->tail->previous;
+	int count = other->size;
+	if (list->pool != other->pool) {
+		// The nodes must not outlive their allocator, so copy them
+		first = copyChain(list, first, count, &last);
+		if (first == NULL) {
+			return SP_LIST_OUT_OF_MEMORY;
+		}
+		spListClear(other);
+	} else {
+		other->head->next = other->tail;
+		other->tail->previous = other->head;
+		other->size = 0;
+		other->current = NULL;
+	}
+	linkChain(list, after, first, last, count);
+	return SP_LIST_SUCCESS;
+}
+
+SP_LIST_MSG spListConcat(SPList list, SPList other) {
+	if (list == NULL || other == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	if (list == other) {
+		return SP_LIST_SUCCESS;
+	}
+	return moveAfter(list, list->tail->previous, other);
+}
+
+SP_LIST_MSG spListSplice(SPList list, SPList other) {
+	if (list == NULL || other == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	if (list->current == NULL) {
+		return SP_LIST_INVALID_CURRENT;
+	}
+	if (list == other) {
+		return SP_LIST_SUCCESS;
+	}
+	return moveAfter(list, list->current, other);
+}
+
+static bool nodeLessOrEqual(const struct sp_list_node_t* n1, const struct sp_list_node_t* n2) {
+	return !spListElementValueIsLess(n2->data, n1->data);
+}
+
+/*
+ * Cuts the non-decreasing run which starts at first from the rest of the
+ * chain. Sets rest to the node after the run.
+ */
+static Node cutRun(Node first, Node* rest) {
+	Node node = first;
+	while (node->next != NULL && nodeLessOrEqual(node, node->next)) {
+		node = node->next;
+	}
+	*rest = node->next;
+	node->next = NULL;
+	return first;
+}
+
+/*
+ * Merges two sorted chains linked through their next fields. Sets last to
+ * the last node of the merged chain and returns its first node.
+ */
+static Node mergeRuns(Node first, Node second, Node* last) {
+	struct sp_list_node_t start;
+	Node merged = &start;
+	while (first != NULL && second != NULL) {
+		if (nodeLessOrEqual(first, second)) {
+			merged->next = first;
+			first = first->next;
+		} else {
+			merged->next = second;
+			second = second->next;
+		}
+		merged = merged->next;
+	}
+	merged->next = first != NULL ? first : second;
+	while (merged->next != NULL) {
+		merged = merged->next;
+	}
+	*last = merged;
+	return start.next;
+}
+
+SP_LIST_MSG spListSort(SPList list) {
+	if (list == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	list->current = NULL;
+	if (list->size < 2) {
+		return SP_LIST_SUCCESS;
+	}
+	// Natural bottom-up merge sort: every pass merges pairs of sorted runs,
+	// using only the next fields, until a single run is left
+	Node chain = list->head->next;
+	list->tail->previous->next = NULL;
+	int merges;
+	do {
+		Node result = NULL, resultLast = NULL, rest = chain;
+		merges = 0;
+		while (rest != NULL) {
+			Node first = cutRun(rest, &rest);
+			Node second = rest != NULL ? cutRun(rest, &rest) : NULL;
+			Node last;
+			Node merged = mergeRuns(first, second, &last);
+			if (resultLast == NULL) {
+				result = merged;
+			} else {
+				resultLast->next = merged;
+			}
+			resultLast = last;
+			merges++;
+		}
+		chain = result;
+	} while (merges > 1);
+	Node previous = list->head;
+	for (Node node = chain; node != NULL; node = node->next) {
+		node->previous = previous;
+		previous->next = node;
+		previous = node;
+	}
+	previous->next = list->tail;
+	list->tail->previous = previous;
+	return SP_LIST_SUCCESS;
+}
+
+SPList spListCreateSorted(const int* indexes, const double* values, int n) {
+	SPList list = spListCreateWithPool(NULL);	// All the nodes in a single slab
+	if (list == NULL) {
+		return NULL;
+	}
+	if (spListAppendArray(list, indexes, values, n) != SP_LIST_SUCCESS) {
+		spListDestroy(list);
+		return NULL;
+	}
+	spListSort(list);
+	return list;
+}
+
+SPListElement spListPeekFirst(SPList list) {
+	if (list == NULL || list->size == 0) {
+		return NULL;
+	}
+	return &list->head->next->data;
+}
+
+SPListElement spListPeekLast(SPList list) {
+	if (list == NULL || list->size == 0) {
+		return NULL;
+	}
+	return &list->tail->previous->data;
+}
+
+SPListIterator spListIteratorFirst(SPList list) {
+	SPListIterator iterator = { NULL };
+	if (list != NULL && list->size > 0) {
+		iterator.node = list->head->next;
+	}
+	return iterator;
+}
+
+SPListIterator spListIteratorLast(SPList list) {
+	SPListIterator iterator = { NULL };
+	if (list != NULL && list->size > 0) {
+		iterator.node = list->tail->previous;
+	}
+	return iterator;
+}
+
+/*
+ * The sentinels are the only nodes without a next or a previous node, and
+ * an iterator which reaches one of them becomes invalid.
+ */
+SPListIterator spListIteratorNext(SPListIterator iterator) {
+	if (iterator.node != NULL) {
+		iterator.node = iterator.node->next;
+		if (iterator.node->next == NULL) {
+			iterator.node = NULL;
+		}
+	}
+	return iterator;
+}
+
+SPListIterator spListIteratorPrevious(SPListIterator iterator) {
+	if (iterator.node != NULL) {
+		iterator.node = iterator.node->previous;
+		if (iterator.node->previous == NULL) {
+			iterator.node = NULL;
+		}
+	}
+	return iterator;
+}
+
+bool spListIteratorIsValid(SPListIterator iterator) {
+	return iterator.node != NULL;
+}
+
+SPListElementValue spListIteratorGetValue(SPListIterator iterator) {
+	assert(iterator.node != NULL);
+	return iterator.node->data;
+}
+
+SPListElement spListIteratorGet(SPListIterator iterator) {
+	if (iterator.node == NULL) {
+		return NULL;
+	}
+	return (SPListElement) &iterator.node->data;
+}
+
 SP_LIST_MSG spListClear(SPList list) {
 	if (list == NULL) {
 		return SP_LIST_NULL_ARGUMENT;
 	}
-	while (spListGetFirst(list)) {
-		spListRemoveCurrent(list);
+	if (list->pool == NULL) {
+		while (spListGetFirst(list)) {
+			spListRemoveCurrent(list);
+		}
+		return SP_LIST_SUCCESS;
 	}
+	if (list->size > 0) {
+		// The nodes are already linked by their next fields, so the whole
+		// chain is pushed onto the pool's free list at once
+		Node first = list->head->next;
+		Node last = list->tail->previous;
+		last->next = list->pool->free;
+		list->pool->free = first;
+		list->head->next = list->tail;
+		list->tail->previous = list->head;
+		list->size = 0;
+	}
+	list->current = NULL;
 	return SP_LIST_SUCCESS;
 }
 
@@ -243,7 +732,11 @@ void spListDestroy(SPList list) {
 		return;
 	}
 	spListClear(list);
-	destroyNode(list->head);
-	destroyNode(list->tail);
+	if (list->ownsPool) {
+		spListNodePoolDestroy(list->pool);	// Frees the sentinels with the slabs
+	} else {
+		destroyNode(list, list->head);
+		destroyNode(list, list->tail);
+	}
 	free(list);
 }
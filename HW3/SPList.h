@@ -9,6 +9,9 @@
  * Implements a list container type.
  * The elements of the list are of type SPListElement, please refer
  * to SPListElement.h for usage.
+ * Inserted elements are copied into the list's nodes. An element returned by
+ * the list points into its node, is owned by the list and must not be
+ * destroyed; it stays valid until it is removed from the list.
  * The list has an internal iterator for external use. For all functions
  * where the state of the iterator after calling that function is not stated,
  * the state of the iterator is undefined. That is you cannot assume anything about it.
@@ -44,17 +47,76 @@
  *   spListGetPrevious		    - Moves the list's iterator to the previous element
  *                                and return it
  *   spListClear		      	- Clears all the data from the list
+ *   spListInsertFirstValue     - Same as spListInsertFirst, for an element value
+ *   spListInsertLastValue      - Same as spListInsertLast, for an element value
+ *   spListInsertBeforeCurrentValue - Same as spListInsertBeforeCurrent, for an
+ *                                element value
+ *   spListInsertAfterCurrentValue - Same as spListInsertAfterCurrent, for an
+ *                                element value
+ *   spListAppendArray          - Inserts elements given by arrays at the end of
+ *                                the list
+ *   spListConcat               - Moves all elements of another list to the end of
+ *                                the list
+ *   spListSplice               - Moves all elements of another list right after
+ *                                the place of the internal iterator
+ *   spListSort                 - Sorts the elements of the list in place
+ *   spListCreateSorted         - Creates a sorted list from arrays of indexes and
+ *                                values
+ *   spListPeekFirst            - Returns the first element without using the
+ *                                internal iterator
+ *   spListPeekLast             - Returns the last element without using the
+ *                                internal iterator
+ *   spListIteratorFirst        - Returns an external iterator to the first element
+ *   spListIteratorLast         - Returns an external iterator to the last element
+ *   spListIteratorNext         - Advances an external iterator
+ *   spListIteratorPrevious     - Moves an external iterator backwards
+ *   spListIteratorIsValid      - Decides whether an external iterator points to
+ *                                an element
+ *   spListIteratorGet          - Returns the element an external iterator points to
+ *   spListIteratorGetValue     - Returns the element an external iterator points
+ *                                to, by value
+ *   spListCreateWithPool       - Creates a new empty list whose nodes come from
+ *                                a node pool
+ *   spListNodePoolCreate       - Creates a new node pool
+ *   spListNodePoolDestroy      - Frees a node pool and all its nodes
+ *
+ * External Iterators
+ *
+ * An SPListIterator is a small value which points to an element of a list, and
+ * is advanced by returning a new iterator. External iterators and the peek
+ * functions never change the list, so any number of them may be used at once:
+ * in nested loops, or by several threads which read a list that no thread
+ * changes. An external iterator stays valid until the element it points to is
+ * removed from the list.
+ *
+ * Node Pools
+ *
+ * By default every node of a list is allocated with malloc and freed when its
+ * element is removed. A list may instead take its nodes from a node pool,
+ * which allocates nodes in slabs and keeps removed nodes on a free list for
+ * reuse. Clearing a pooled list returns all its nodes to the pool at once.
+ * A pool is either owned by a single list, or shared by several lists which
+ * are used by the same thread. A pool is not thread-safe.
  */
 
 /** Type for defining the list */
 typedef struct sp_list_t *SPList;
 
+/** Type for defining a pool of list nodes */
+typedef struct sp_list_node_pool_t *SPListNodePool;
+
+/** Type for iterating over a list without changing it */
+typedef struct sp_list_iterator_t {
+	const struct sp_list_node_t *node;	// NULL if the iterator is invalid
+} SPListIterator;
+
 /** Type used for returning error codes from list functions */
 typedef enum sp_list_msg_t {
 	SP_LIST_SUCCESS,
 	SP_LIST_NULL_ARGUMENT,
 	SP_LIST_OUT_OF_MEMORY,
 	SP_LIST_INVALID_CURRENT,
+	SP_LIST_INVALID_ARGUMENT,
 } SP_LIST_MSG;
 
 /**
@@ -67,12 +129,47 @@ typedef enum sp_list_msg_t {
  */
 SPList spListCreate();
 
+/**
+ * Allocates a new List whose nodes are taken from a node pool.
+ *
+ * If pool is NULL, the new list creates a pool of its own which is freed
+ * together with the list. Otherwise the list shares the given pool, which
+ * must not be destroyed before the list.
+ *
+ * @param pool The pool to take the nodes from, or NULL for a private pool.
+ * @return
+ * 	NULL - If allocations failed.
+ * 	A new List in case of success.
+ */
+SPList spListCreateWithPool(SPListNodePool pool);
+
+/**
+ * Allocates a new node pool. The pool allocates nodes in slabs of
+ * nodesPerSlab nodes, and a slab is freed only when the pool is destroyed.
+ *
+ * @param nodesPerSlab The number of nodes allocated at once.
+ * @return
+ * 	NULL - If allocations failed or nodesPerSlab is less than 1.
+ * 	A new node pool in case of success.
+ */
+SPListNodePool spListNodePoolCreate(int nodesPerSlab);
+
+/**
+ * Deallocates a node pool and all its nodes. All lists using the pool must
+ * be destroyed before the pool.
+ *
+ * @param pool Target pool to be deallocated. If pool is NULL nothing will be
+ * done
+ */
+void spListNodePoolDestroy(SPListNodePool pool);
+
 /**
  * Creates a copy of target list.
  *
  * The new copy will contain all the elements from the source list in the same
- * order. The internal iterator for both the new copy and the target list will not be
- * defined afterwards.
+ * order. The internal iterator of the target list will not be changed, and the
+ * internal iterator of the new copy will not be defined. The copy takes its nodes from the same pool as the source
+ * list, or from a private pool if the source list owns its pool.
  *
  * @param list The target list to copy
  * @return
@@ -167,6 +264,7 @@ SPListElement spListGetPrevious(SPList list);
 
 /**
  * Returns the current element (pointed by the iterator)
+ * The returned pointer stays valid until the element is removed.
  *
  * @param list The list for which to get the iterator
  * @return
@@ -237,6 +335,56 @@ SP_LIST_MSG spListInsertBeforeCurrent(SPList list, SPListElement element);
  */
 SP_LIST_MSG spListInsertAfterCurrent(SPList list, SPListElement element);
 
+/**
+ * Same as spListInsertFirst, but the new element is given by value and nothing
+ * but the node is allocated.
+ *
+ * @return
+ * SP_LIST_NULL_ARGUMENT if a NULL was sent as list
+ * SP_LIST_INVALID_ARGUMENT if the index or the value of element is negative
+ * SP_LIST_OUT_OF_MEMORY if an allocation failed
+ * SP_LIST_SUCCESS the element has been inserted successfully
+ */
+SP_LIST_MSG spListInsertFirstValue(SPList list, SPListElementValue element);
+
+/**
+ * Same as spListInsertLast, but the new element is given by value and nothing
+ * but the node is allocated.
+ *
+ * @return
+ * SP_LIST_NULL_ARGUMENT if a NULL was sent as list
+ * SP_LIST_INVALID_ARGUMENT if the index or the value of element is negative
+ * SP_LIST_OUT_OF_MEMORY if an allocation failed
+ * SP_LIST_SUCCESS the element has been inserted successfully
+ */
+SP_LIST_MSG spListInsertLastValue(SPList list, SPListElementValue element);
+
+/**
+ * Same as spListInsertBeforeCurrent, but the new element is given by value and
+ * nothing but the node is allocated.
+ *
+ * @return
+ * SP_LIST_NULL_ARGUMENT if a NULL was sent as list
+ * SP_LIST_INVALID_ARGUMENT if the index or the value of element is negative
+ * SP_LIST_INVALID_CURRENT if the list's iterator is in an invalid state
+ * SP_LIST_OUT_OF_MEMORY if an allocation failed
+ * SP_LIST_SUCCESS the element has been inserted successfully
+ */
+SP_LIST_MSG spListInsertBeforeCurrentValue(SPList list, SPListElementValue element);
+
+/**
+ * Same as spListInsertAfterCurrent, but the new element is given by value and
+ * nothing but the node is allocated.
+ *
+ * @return
+ * SP_LIST_NULL_ARGUMENT if a NULL was sent as list
+ * SP_LIST_INVALID_ARGUMENT if the index or the value of element is negative
+ * SP_LIST_INVALID_CURRENT if the list's iterator is in an invalid state
+ * SP_LIST_OUT_OF_MEMORY if an allocation failed
+ * SP_LIST_SUCCESS the element has been inserted successfully
+ */
+SP_LIST_MSG spListInsertAfterCurrentValue(SPList list, SPListElementValue element);
+
 /**
  * Removes the currently pointed element of the list using the stored freeing
  * function. The state of the current element will not be defined afterwards.
@@ -260,6 +408,183 @@ SP_LIST_MSG spListRemoveCurrent(SPList list);
  */
 SP_LIST_MSG spListClear(SPList list);
 
+/**
+ * Adds n new elements to the end of the list. The i-th new element has the index
+ * indexes[i] and the value values[i]. The state of the iterator will not be changed.
+ *
+ * All nodes needed by a list which takes its nodes from a pool are taken from the
+ * pool's free nodes and from a single new block; otherwise each node is allocated
+ * on its own. If an allocation fails, the list is not changed.
+ *
+ * @param list The list for which to add the elements in its end
+ * @param indexes The indexes of the new elements
+ * @param values The values of the new elements
+ * @param n The number of new elements. Nothing is added if n is not positive
+ * @return
+ * SP_LIST_NULL_ARGUMENT if a NULL was sent as list, or as an array while n > 0
+ * SP_LIST_INVALID_ARGUMENT if any of the indexes or values is negative
+ * SP_LIST_OUT_OF_MEMORY if an allocation failed
+ * SP_LIST_SUCCESS the elements have been inserted successfully
+ */
+SP_LIST_MSG spListAppendArray(SPList list, const int* indexes, const double* values, int n);
+
+/**
+ * Moves all the elements of other to the end of list, in the same order, leaving
+ * other empty. The state of the iterator of list will not be changed, and the
+ * iterator of other will not be defined afterwards.
+ *
+ * If both lists take their nodes from the same pool, or both use malloc, the nodes
+ * themselves are moved in O(1). Otherwise the elements are copied to new nodes of
+ * list in O(n). Nothing is done if list and other are the same list.
+ *
+ * @param list The list to which the elements are moved
+ * @param other The list whose elements are moved
+ * @return
+ * SP_LIST_NULL_ARGUMENT if a NULL was sent as list or other
+ * SP_LIST_OUT_OF_MEMORY if an allocation failed (both lists are not changed)
+ * SP_LIST_SUCCESS the elements have been moved successfully
+ */
+SP_LIST_MSG spListConcat(SPList list, SPList other);
+
+/**
+ * Moves all the elements of other right after the current element of list (As
+ * pointed by the inner iterator of the list), in the same order, leaving other
+ * empty. Same as spListConcat otherwise.
+ *
+ * @param list The list to which the elements are moved
+ * @param other The list whose elements are moved
+ * @return
+ * SP_LIST_NULL_ARGUMENT if a NULL was sent as list or other
+ * SP_LIST_INVALID_CURRENT if the list's iterator is in an invalid state (Does
+ * not point to a legal element in the list)
+ * SP_LIST_OUT_OF_MEMORY if an allocation failed (both lists are not changed)
+ * SP_LIST_SUCCESS the elements have been moved successfully
+ */
+SP_LIST_MSG spListSplice(SPList list, SPList other);
+
+/**
+ * Sorts the elements of the list by spListElementCompare, in place. The nodes are
+ * relinked and nothing is allocated. Runs of elements which are already sorted are
+ * detected, so sorting takes O(n) for a sorted list and O(n log n) in general.
+ * The state of the iterator will not be defined afterwards.
+ *
+ * @param list The list to sort
+ * @return
+ * SP_LIST_NULL_ARGUMENT if a NULL was sent as list
+ * SP_LIST_SUCCESS the list has been sorted successfully
+ */
+SP_LIST_MSG spListSort(SPList list);
+
+/**
+ * Allocates a new list holding n elements sorted by spListElementCompare. The
+ * elements are given by arrays as in spListAppendArray, in any order. The list
+ * takes its nodes from a private pool (see spListCreateWithPool), so all n
+ * nodes are allocated at once.
+ *
+ * @param indexes The indexes of the elements
+ * @param values The values of the elements
+ * @param n The number of elements
+ * @return
+ * NULL if allocations failed, if an array is NULL while n > 0, or if any of
+ * the indexes or values is negative.
+ * A new sorted list in case of success.
+ */
+SPList spListCreateSorted(const int* indexes, const double* values, int n);
+
+/**
+ * Returns the first element of the list. The internal iterator will not be changed.
+ *
+ * @param list The list whose first element is requested
+ * @return
+ * NULL if a NULL pointer was sent or the list is empty.
+ * The first element of the list otherwise
+ */
+SPListElement spListPeekFirst(SPList list);
+
+/**
+ * Returns the last element of the list. The internal iterator will not be changed.
+ *
+ * @param list The list whose last element is requested
+ * @return
+ * NULL if a NULL pointer was sent or the list is empty.
+ * The last element of the list otherwise
+ */
+SPListElement spListPeekLast(SPList list);
+
+/**
+ * Returns an external iterator which points to the first element of the list.
+ * The list is not changed.
+ *
+ * @param list The list to iterate over
+ * @return
+ * An invalid iterator if a NULL pointer was sent or the list is empty.
+ * An iterator to the first element otherwise
+ */
+SPListIterator spListIteratorFirst(SPList list);
+
+/**
+ * Returns an external iterator which points to the last element of the list.
+ * The list is not changed.
+ *
+ * @param list The list to iterate over
+ * @return
+ * An invalid iterator if a NULL pointer was sent or the list is empty.
+ * An iterator to the last element otherwise
+ */
+SPListIterator spListIteratorLast(SPList list);
+
+/**
+ * Returns an iterator to the element which follows the element of the given
+ * iterator.
+ *
+ * @param iterator The current iterator
+ * @return
+ * An invalid iterator if the given iterator is invalid or points to the last element.
+ * An iterator to the next element otherwise
+ */
+SPListIterator spListIteratorNext(SPListIterator iterator);
+
+/**
+ * Returns an iterator to the element which precedes the element of the given
+ * iterator.
+ *
+ * @param iterator The current iterator
+ * @return
+ * An invalid iterator if the given iterator is invalid or points to the first element.
+ * An iterator to the previous element otherwise
+ */
+SPListIterator spListIteratorPrevious(SPListIterator iterator);
+
+/**
+ * Decides whether an external iterator points to an element.
+ *
+ * @param iterator The query iterator
+ * @return
+ * true if the iterator points to an element, false otherwise
+ */
+bool spListIteratorIsValid(SPListIterator iterator);
+
+/**
+ * Returns the element an external iterator points to. The element is owned by the
+ * list and must not be destroyed.
+ *
+ * @param iterator The query iterator
+ * @return
+ * NULL if the iterator is invalid.
+ * The element the iterator points to otherwise
+ */
+SPListElement spListIteratorGet(SPListIterator iterator);
+
+/**
+ * Returns a copy of the element an external iterator points to.
+ *
+ * @param iterator The query iterator
+ * @assert spListIteratorIsValid(iterator)
+ * @return
+ * The element the iterator points to, by value
+ */
+SPListElementValue spListIteratorGetValue(SPListIterator iterator);
+
 /**
  * listDestroy: Deallocates an existing list. Clears all elements by using the
  * stored free function.
@@ -305,5 +630,24 @@ void spListDestroy(SPList list);
 		iterator ;\
 		iterator = spListGetNext(list))
 
+/**
+ * Macro for iterating over a list with an external iterator, without changing
+ * the list or its internal iterator. Declares a new SPListIterator variable;
+ * use spListIteratorGet to get its element.
+ *
+ * @code
+ * SP_LIST_ITERATOR_FOREACH(it, list) {
+ *   double value = spListElementGetValue(spListIteratorGet(it));
+ * }
+ * @endcode
+ *
+ * @param iterator The name of the iterator variable
+ * @param list the list to iterate over
+ */
+#define SP_LIST_ITERATOR_FOREACH(iterator,list) \
+	for(SPListIterator iterator = spListIteratorFirst(list) ; \
+		spListIteratorIsValid(iterator) ;\
+		iterator = spListIteratorNext(iterator))
+
 
 #endif /* SPLIST_H_ */
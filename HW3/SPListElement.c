@@ -3,11 +3,6 @@
 #include <string.h>
 #include <assert.h>
 
-struct sp_list_element_t {
-	int index;
-	double value;
-};
-
 SPListElement spListElementCreate(int index, double value) {
 	SPListElement temp = NULL;
 	if(index < 0 || value <0.0){
@@ -17,8 +12,7 @@ SPListElement spListElementCreate(int index, double value) {
 	if (temp == NULL) { //Allocation Fails
 		return NULL;
 	}
-	temp->index = index;
-	temp->value = value;
+	*temp = spListElementValueCreate(index, value);
 	return temp;
 }
 
@@ -31,8 +25,7 @@ SPListElement spListElementCopy(SPListElement data) {
 	if (elementCopy == NULL) {
 		return NULL;
 	}
-	elementCopy->index = data->index;
-	elementCopy->value = data->value;
+	*elementCopy = *data;
 	return elementCopy;
 }
 
@@ -75,10 +68,14 @@ double spListElementGetValue(SPListElement data) {
 
 int spListElementCompare(SPListElement e1, SPListElement e2){
 	assert(e1!=NULL && e2!=NULL);
-	if(e1->value == e2->value){
-		return e1->index - e2->index;
-	}else if(e1->value > e2->value){
-		return 1;
-	}
-	return -1;
+	return spListElementValueCompare(*e1, *e2);
+}
+
+SPListElementValue spListElementToValue(SPListElement data) {
+	assert(data != NULL);
+	return *data;
+}
+
+SPListElement spListElementCreateFromValue(SPListElementValue data) {
+	return spListElementCreate(data.index, data.value);
 }
@@ -24,8 +24,29 @@
  *  spListElementGetIndex  - Gets a the index of the target  element
  *  spListElementSetValue  - Sets a new value to the target element.
  *  spLostElementGetValue  - Gets a the value of the target element
+ *  spListElementToValue   - Returns a copy of the target element by value
+ *  spListElementCreateFromValue - Creates a new element from an element value
+ *
+ * Element Values
+ *
+ * An SPListElementValue is the element itself as a plain struct, which may be
+ * declared on the stack, stored in arrays and passed by value without any
+ * allocation. An SPListElement is a pointer to such a struct. The following
+ * inline functions work on element values:
+ *
+ *  spListElementValueCreate    - Returns an element value with the given index and value
+ *  spListElementValueCompare   - Compares two element values
+ *  spListElementValueIsLess    - Decides whether an element value is less than another
+ *  spListElementValueIsValid   - Decides whether an element value may be stored
+ *  spListElementValueGetIndex  - Gets the index of an element value
+ *  spListElementValueGetValue  - Gets the value of an element value
+ *  spListElementValueSetIndex  - Sets a new index to an element value
+ *  spListElementValueSetValue  - Sets a new value to an element value
  */
 
+#include <stdbool.h>
+#include <stddef.h>
+
 /** Type used for error reporting in SPListElement*/
 typedef enum SP_LIST_ELEMENT_RESULT_t {
 	SP_ELEMENT_SUCCESS,
@@ -33,6 +54,12 @@ typedef enum SP_LIST_ELEMENT_RESULT_t {
 	SP_ELEMENT_OUT_OF_MEMORY
 } SP_ELEMENT_MSG;
 
+/** Type used to hold an element by value **/
+typedef struct sp_list_element_t {
+	int index;
+	double value;
+} SPListElementValue;
+
 /** Type used represent an element in the list **/
 typedef struct sp_list_element_t * SPListElement;
 
@@ -138,4 +165,142 @@ SP_ELEMENT_MSG spListElementSetValue(SPListElement data, double newValue);
  */
 double spListElementGetValue(SPListElement data);
 
+/**
+ * Returns a copy of the target element by value.
+ *
+ * @param data The target element
+ * @assert data != NULL
+ * @return
+ * The index and value of the target element
+ */
+SPListElementValue spListElementToValue(SPListElement data);
+
+/**
+ * Creates a new element with the index and value of the given element value.
+ *
+ * @param data The element value
+ * @return
+ * NULL in case of memory allocation fails or the index or value are negative.
+ * A new element with the corresponding index and value.
+ */
+SPListElement spListElementCreateFromValue(SPListElementValue data);
+
+/**
+ * Returns an element value with the given index and value. Nothing is allocated
+ * and the arguments are not checked.
+ *
+ * @param index  The index of the element
+ * @param value  The value of the element
+ * @return
+ * The element value
+ */
+static inline SPListElementValue spListElementValueCreate(int index, double value) {
+	SPListElementValue data;
+	data.index = index;
+	data.value = value;
+	return data;
+}
+
+/**
+ * Compares two element values, by the same relation as spListElementCompare.
+ *
+ * @param e1 The first element value to be compared
+ * @param e2 The second element value to be compared with
+ * @return
+ * -1 if e1 is less than e2
+ * 0  if e1 and e2 are equal
+ * 1  if e1 is bigger than e2
+ */
+static inline int spListElementValueCompare(SPListElementValue e1, SPListElementValue e2) {
+	if (e1.value != e2.value) {
+		return e1.value < e2.value ? -1 : 1;
+	}
+	if (e1.index != e2.index) {
+		return e1.index < e2.index ? -1 : 1;
+	}
+	return 0;
+}
+
+/**
+ * Decides whether an element value is less than another one.
+ *
+ * @param e1 The first element value to be compared
+ * @param e2 The second element value to be compared with
+ * @return
+ * true if e1 is less than e2, false otherwise
+ */
+static inline bool spListElementValueIsLess(SPListElementValue e1, SPListElementValue e2) {
+	return e1.value < e2.value || (e1.value == e2.value && e1.index < e2.index);
+}
+
+/**
+ * Decides whether an element value is valid, that is whether its index and
+ * its value are both greater or equal to 0, as for spListElementCreate.
+ *
+ * @param data The element value
+ * @return
+ * true if the element value is valid, false otherwise
+ */
+static inline bool spListElementValueIsValid(SPListElementValue data) {
+	return data.index >= 0 && data.value >= 0;
+}
+
+/**
+ * A getter for the index of an element value.
+ *
+ * @param data The element value
+ * @return
+ * The index of the element value
+ */
+static inline int spListElementValueGetIndex(SPListElementValue data) {
+	return data.index;
+}
+
+/**
+ * A getter for the value of an element value.
+ *
+ * @param data The element value
+ * @return
+ * The value of the element value
+ */
+static inline double spListElementValueGetValue(SPListElementValue data) {
+	return data.value;
+}
+
+/**
+ * A setter for the index of an element value. The new index must be greater
+ * or equal to 0.
+ *
+ * @param data   The target element value
+ * @param index  The new index to be set
+ * @return
+ * SP_ELEMENT_INVALID_ARGUMENT in case data==NULL || index<0
+ * SP_ELEMENT_SUCCESS otherwise
+ */
+static inline SP_ELEMENT_MSG spListElementValueSetIndex(SPListElementValue* data, int index) {
+	if (data == NULL || index < 0) {
+		return SP_ELEMENT_INVALID_ARGUMENT;
+	}
+	data->index = index;
+	return SP_ELEMENT_SUCCESS;
+}
+
+/**
+ * A setter for the value of an element value. The new value must be greater
+ * or equal to 0.
+ *
+ * @param data   The target element value
+ * @param value  The new value to be set
+ * @return
+ * SP_ELEMENT_INVALID_ARGUMENT in case data==NULL || value<0
+ * SP_ELEMENT_SUCCESS otherwise
+ */
+static inline SP_ELEMENT_MSG spListElementValueSetValue(SPListElementValue* data, double value) {
+	if (data == NULL || value < 0) {
+		return SP_ELEMENT_INVALID_ARGUMENT;
+	}
+	data->value = value;
+	return SP_ELEMENT_SUCCESS;
+}
+
 #endif /* LISTELEMENT_H_ */
@@ -0,0 +1,33 @@
+#include "SPLogger.h"
+#include <stdio.h>
+
+/**
+ * splog-decode - renders a log written by a binary logger, or the file of a
+ * flight recorder, in the text format.
+ *
+ * Usage: splog-decode <binary log or flight recorder> [<text log>]
+ * The text is written to stdout if no text log is given.
+ */
+int main(int argc, char** argv) {
+	if (argc < 2 || argc > 3) {
+		fprintf(stderr, "Usage: %s <binary log or flight recorder> [<text log>]\n", argv[0]);
+		return 1;
+	}
+	switch (spLoggerDecode(argv[1], argc == 3 ? argv[2] : NULL)) {
+	case SP_LOGGER_SUCCESS:
+		return 0;
+	case SP_LOGGER_CANNOT_OPEN_FILE:
+		fprintf(stderr, "%s: cannot open file\n", argv[0]);
+		break;
+	case SP_LOGGER_OUT_OF_MEMORY:
+		fprintf(stderr, "%s: out of memory\n", argv[0]);
+		break;
+	case SP_LOGGER_WRITE_FAIL:
+		fprintf(stderr, "%s: write failed\n", argv[0]);
+		break;
+	default:
+		fprintf(stderr, "%s: %s is not a valid binary log or flight recorder\n", argv[0], argv[1]);
+		break;
+	}
+	return 1;
+}
@@ -1,91 +1,1049 @@
+#define _POSIX_C_SOURCE 200809L
+#define _GNU_SOURCE //For fallocate
 #include "SPLogger.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
 
 //File open mode
 #define SP_LOGGER_OPEN_MODE "w"
 
+//Records up to this length are formatted on the stack
+#define SP_LOGGER_RECORD_BUFFER 512
 
+//Text stored inside a ring slot, so a slot takes 256 bytes
+#define SP_LOGGER_SLOT_TEXT 216
+
+//How long the writer sleeps when the ring is empty, and a blocked print waits
+#define SP_LOGGER_WRITER_IDLE_NS 10000000
+#define SP_LOGGER_PRODUCER_WAIT_NS 50000
+
+//Suffix of the preallocated file a rotating logger switches to next
+#define SP_LOGGER_SPARE_SUFFIX ".next"
+
+//Suffix of the previous file of a flight recorder, kept when a new recorder opens its file
+#define SP_LOGGER_PREVIOUS_SUFFIX ".prev"
+
+//Room for the longest suffix of a rotated file
+#define SP_LOGGER_SUFFIX_LENGTH 16
+
+//How often the suppressed records of a call site are reported, at most
+#define SP_LOGGER_SUMMARY_SECONDS 1
+
+//Binary log files start with this header
+#define SP_LOGGER_BINARY_MAGIC "SPLOGB1\n"
+#define SP_LOGGER_BINARY_MAGIC_LENGTH 8
+
+//Long enough for the file the decoder prints for a site that was never described
+#define SP_LOGGER_UNKNOWN_SITE_LENGTH 32
+
+//Flight recorder files start with this header, which is as long as the binary one
+#define SP_LOGGER_RECORDER_MAGIC "SPLOGF1\n"
+
+//Size of a flight recorder slot, and the longest file and function it keeps
+#define SP_LOGGER_RECORDER_SLOT 256
+#define SP_LOGGER_RECORDER_NAME 63
+
+//The sequence of a flight recorder slot while a record is copied into it
+#define SP_LOGGER_RECORDER_BUSY UINT64_MAX
+
+/**
+ * The first byte of each binary record. The fields follow without padding;
+ * strings are written as a uint32_t length and their bytes.
+ */
+typedef enum sp_logger_binary_tag_t {
+	SP_LOGGER_SITE_TAG = 'S', //uint32_t id, uint8_t type, int32_t line, file, function
+	SP_LOGGER_EVENT_TAG = 'E', //uint32_t site id, uint64_t time, message
+	SP_LOGGER_FULL_TAG = 'F' //uint8_t type, uint64_t time, int32_t line, file, function, message
+} SP_LOGGER_BINARY_TAG;
+
+/** A binary record read by spLoggerDecode **/
+typedef struct sp_logger_binary_record_t {
+	SP_LOGGER_BINARY_TAG tag;
+	uint32_t id;
+	uint8_t type;
+	int32_t line;
+	uint64_t time;
+	char* file;
+	char* function;
+	char* msg;
+} BinaryRecord;
+
+/**
+ * A record waiting in the ring. The strings are copied into text one after
+ * the other (msg, file, function), or into heapText if they do not fit.
+ */
+typedef struct sp_logger_slot_t {
+	size_t sequence; //Ring position the slot is ready for (see enqueueRecord)
+	SP_LOGGER_RECORD_TYPE type;
+	int line;
+	char* heapText;
+	int fileOffset;
+	int functionOffset;
+	char text[SP_LOGGER_SLOT_TEXT];
+} Slot;
+
+/** The start of a flight recorder file, followed by its slots **/
+typedef struct sp_logger_recorder_header_t {
+	char magic[SP_LOGGER_BINARY_MAGIC_LENGTH];
+	uint32_t slotSize;
+	uint32_t slotCount;
+	uint64_t next; //The sequence number of the next record
+} RecorderHeader;
+
+/**
+ * A record in a flight recorder file. The strings are stored in text one
+ * after the other (msg, file, function), each terminated by a null byte.
+ */
+typedef struct sp_logger_recorder_slot_t {
+	uint64_t sequence; //The record's sequence number plus one, SP_LOGGER_RECORDER_BUSY while it is written
+	int32_t line;
+	uint8_t type;
+	uint8_t unused;
+	uint16_t fileOffset;
+	uint16_t functionOffset;
+	uint16_t length; //Of the strings, including their null bytes
+	char text[SP_LOGGER_RECORDER_SLOT - 20];
+} RecorderSlot;
+
+/** The memory mapped file of a flight recorder **/
+typedef struct sp_logger_recorder_t {
+	RecorderHeader* header;
+	RecorderSlot* slots;
+	size_t size; //Of the mapping
+	unsigned long dropped; //Records whose slot was still being written
+} *SPLoggerRecorder;
+
+/** When a rotating logger switches to a new file **/
+typedef struct sp_logger_rotation_limits_t {
+	long maxBytes; //0 for no size limit
+	int maxSeconds; //0 for no time limit
+	int fileCount; //The log file and the rotated files
+} RotationLimits;
+
+/** The files of a rotating logger, used by the writer thread only **/
+typedef struct sp_logger_rotation_t {
+	RotationLimits limits;
+	char* filename;
+	char* spareName; //filename with SP_LOGGER_SPARE_SUFFIX
+	char* fromName; //Scratch buffers for renaming the rotated files
+	char* toName;
+	int spare; //Descriptor of the preallocated next file, or -1
+	long written; //Bytes written to the current file
+	time_t opened; //When the current file was opened
+} *SPLoggerRotation;
+
+/** The ring buffer and the writer thread of an asynchronous logger **/
+typedef struct sp_logger_async_t {
+	Slot* slots;
+	size_t mask; //Number of slots minus one
+	size_t enqueuePosition; //Claimed by producers with compare-and-swap
+	size_t dequeuePosition; //Used by the writer only
+	SP_LOGGER_OVERFLOW_POLICY policy;
+	unsigned long dropped; //Records dropped because the ring was full
+	unsigned long reported; //Dropped records already reported by the writer
+	bool stopping;
+	bool writerSleeping;
+	pthread_t writer;
+	pthread_mutex_t lock; //Guards the writer's sleep
+	pthread_cond_t wakeUp;
+} *SPLoggerAsync;
 
 // Global variable holding the logger
 SPLogger logger = NULL;
 
+// The level of the logger, or -1, for the SP_LOG_* macros
+int spLoggerActiveLevel = -1;
+
+// Serializes creating and destroying the logger
+static pthread_mutex_t lifecycleLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Number of print calls using the logger, which destroy waits for
+static int activeCalls = 0;
+
+// The last serial given to a binary logger, and the last id given to a site
+static unsigned int lastSerial = 0;
+static int lastSiteId = 0;
+
 struct sp_logger_t {
 	FILE* outputChannel; //The logger file
 	bool isStdOut; //Indicates if the logger is stdout
 	SP_LOGGER_LEVEL level; //Indicates the level
+	SPLoggerAsync async; //NULL if records are written by the print functions
+	unsigned int serial; //Positive for a binary logger, 0 for a text logger
+	SPLoggerRotation rotation; //NULL if the logger writes a single file
+	SPLoggerRecorder recorder; //NULL unless the logger is a flight recorder
 };
 
-SP_LOGGER_MSG spLoggerCreate(const char* filename, SP_LOGGER_LEVEL level) {
-	if (logger != NULL) { //Already defined
-		return SP_LOGGER_DEFINED;
+/** How publishLogger sets up a new logger **/
+typedef struct sp_logger_options_t {
+	int capacity; //Of the ring of an asynchronous logger, 0 for a synchronous logger
+	SP_LOGGER_OVERFLOW_POLICY policy;
+	bool binary;
+	const RotationLimits* limits; //NULL if the file is not rotated
+	int recorderSlots; //Of a flight recorder, 0 for other loggers
+} LoggerOptions;
+
+/*
+ * Formats a record in the format documented in SPLogger.h. Returns the
+ * length of the record, which was truncated if it is not less than size.
+ */
+static int formatRecord(char* buffer, size_t size, SP_LOGGER_RECORD_TYPE type,
+		const char* msg, const char* file, const char* function, int line) {
+	static const char* headers[] = { "---ERROR---", "---WARNING---", "---INFO---",
+			"---DEBUG---", NULL };
+	if (type == SP_LOGGER_MSG_RECORD) {
+		return snprintf(buffer, size, "- message: %s\n", msg);
+	}
+	if (type == SP_LOGGER_INFO_RECORD) {
+		return snprintf(buffer, size, "%s\n- message: %s\n", headers[type], msg);
+	}
+	return snprintf(buffer, size, "%s\n- file: %s\n- function: %s\n- line: %i\n- message: %s\n",
+			headers[type], file ? file : "(null)", function, line, msg);
+}
+
+/*
+ * Writes a record with a single fwrite, so records written by concurrent
+ * threads never interleave. The record is formatted on the stack of the
+ * calling thread, or on the heap if it is long. Adds the number of bytes
+ * written to written, unless it is NULL.
+ */
+static SP_LOGGER_MSG writeRecord(FILE* out, SP_LOGGER_RECORD_TYPE type,
+		const char* msg, const char* file, const char* function, int line,
+		long* written) {
+	char buffer[SP_LOGGER_RECORD_BUFFER];
+	char* record = buffer;
+	if (out == NULL) { //Open failed
+		return SP_LOGGER_WRITE_FAIL;
+	}
+	int length = formatRecord(buffer, sizeof(buffer), type, msg, file, function, line);
+	if (length < 0) {
+		return SP_LOGGER_WRITE_FAIL;
+	}
+	if ((size_t) length >= sizeof(buffer)) { //Long record
+		record = (char*) malloc((size_t) length + 1);
+		if (record == NULL) { //Allocation failure
+			return SP_LOGGER_OUT_OF_MEMORY;
+		}
+		formatRecord(record, (size_t) length + 1, type, msg, file, function, line);
+	}
+	size_t count = fwrite(record, 1, (size_t) length, out);
+	if (record != buffer) {
+		free(record);
+	}
+	if (written != NULL) {
+		*written += (long) count;
+	}
+	return count == (size_t) length ? SP_LOGGER_SUCCESS : SP_LOGGER_WRITE_FAIL;
+}
+
+static uint64_t currentTime() {
+	struct timespec now;
+	clock_gettime(CLOCK_REALTIME, &now);
+	return (uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec;
+}
+
+static char* putBytes(char* position, const void* data, size_t size) {
+	memcpy(position, data, size);
+	return position + size;
+}
+
+static char* putString(char* position, const char* string, uint32_t length) {
+	position = putBytes(position, &length, sizeof(length));
+	return putBytes(position, string, length);
+}
+
+/*
+ * Assigns an id to a site the first time it prints. Two threads may both
+ * draw an id for a new site, in which case one of the ids is not used.
+ */
+static uint32_t siteId(SPLoggerSite* site) {
+	int id = __atomic_load_n(&site->id, __ATOMIC_RELAXED);
+	if (id == 0) {
+		int expected = 0;
+		id = __atomic_add_fetch(&lastSiteId, 1, __ATOMIC_RELAXED);
+		if (!__atomic_compare_exchange_n(&site->id, &expected, id, false,
+				__ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+			id = expected;
+		}
+	}
+	return (uint32_t) id;
+}
+
+/*
+ * Gives a site back the serial it had before a record failed to describe it,
+ * so the next record of the site describes it again.
+ */
+static void restoreSite(SPLoggerSite* site, bool describe, unsigned int previous) {
+	if (describe) {
+		__atomic_store_n(&site->serial, previous, __ATOMIC_RELAXED);
+	}
+}
+
+/*
+ * Writes a binary record with a single fwrite. A record of a site holds the
+ * id of the site, preceded by the description of the site if this is the
+ * first time the logger prints it. Another thread may write a record of the
+ * site before its description, so spLoggerDecode reads all the descriptions
+ * first. A record without a site holds all its fields.
+ */
+static SP_LOGGER_MSG writeBinaryRecord(SPLogger current, SPLoggerSite* site,
+		SP_LOGGER_RECORD_TYPE type, const char* msg, const char* file,
+		const char* function, int line) {
+	char buffer[SP_LOGGER_RECORD_BUFFER];
+	char* record = buffer;
+	uint8_t tag, recordType = (uint8_t) type;
+	uint64_t time = currentTime();
+	int32_t recordLine = line;
+	bool describe = false;
+	unsigned int previous = 0;
+	uint32_t id = 0;
+	SP_LOGGER_MSG result = SP_LOGGER_SUCCESS;
+	if (site != NULL) {
+		id = siteId(site);
+		previous = __atomic_load_n(&site->serial, __ATOMIC_RELAXED);
+		if (previous != current->serial) {
+			previous = __atomic_exchange_n(&site->serial, current->serial, __ATOMIC_RELAXED);
+			describe = previous != current->serial;
+		}
+		file = site->file;
+		function = site->function;
+	}
+	file = file ? file : "(null)";
+	function = function ? function : "";
+	uint32_t msgLength = (uint32_t) strlen(msg);
+	uint32_t fileLength = (uint32_t) strlen(file);
+	uint32_t functionLength = (uint32_t) strlen(function);
+	size_t describeSize = 1 + sizeof(id) + 1 + sizeof(recordLine) + 2 * sizeof(uint32_t) +
+			fileLength + functionLength;
+	size_t length = site != NULL ?
+			(describe ? describeSize : 0) + 1 + sizeof(id) + sizeof(time) + sizeof(uint32_t) + msgLength :
+			describeSize - sizeof(id) + sizeof(time) + sizeof(uint32_t) + msgLength;
+	if (current->outputChannel == NULL) { //Open failed
+		result = SP_LOGGER_WRITE_FAIL;
+	} else if (length > sizeof(buffer)) { //Long record
+		record = (char*) malloc(length);
+		if (record == NULL) { //Allocation failure
+			result = SP_LOGGER_OUT_OF_MEMORY;
+		}
+	}
+	if (result != SP_LOGGER_SUCCESS) {
+		restoreSite(site, describe, previous);
+		return result;
+	}
+	char* position = record;
+	if (site == NULL) {
+		tag = SP_LOGGER_FULL_TAG;
+		position = putBytes(position, &tag, 1);
+		position = putBytes(position, &recordType, 1);
+		position = putBytes(position, &time, sizeof(time));
+		position = putBytes(position, &recordLine, sizeof(recordLine));
+		position = putString(position, file, fileLength);
+		position = putString(position, function, functionLength);
+	} else {
+		if (describe) {
+			tag = SP_LOGGER_SITE_TAG;
+			recordType = (uint8_t) site->type;
+			recordLine = site->line;
+			position = putBytes(position, &tag, 1);
+			position = putBytes(position, &id, sizeof(id));
+			position = putBytes(position, &recordType, 1);
+			position = putBytes(position, &recordLine, sizeof(recordLine));
+			position = putString(position, file, fileLength);
+			position = putString(position, function, functionLength);
+		}
+		tag = SP_LOGGER_EVENT_TAG;
+		position = putBytes(position, &tag, 1);
+		position = putBytes(position, &id, sizeof(id));
+		position = putBytes(position, &time, sizeof(time));
+	}
+	putString(position, msg, msgLength);
+	size_t written = fwrite(record, 1, length, current->outputChannel);
+	if (record != buffer) {
+		free(record);
+	}
+	if (written != length) {
+		restoreSite(site, describe, previous);
+		return SP_LOGGER_WRITE_FAIL;
+	}
+	return SP_LOGGER_SUCCESS;
+}
+
+static void wakeWriter(SPLoggerAsync async) {
+	pthread_mutex_lock(&async->lock);
+	pthread_cond_signal(&async->wakeUp);
+	pthread_mutex_unlock(&async->lock);
+}
+
+/*
+ * Copies a record into the ring. Producers claim ring positions with a
+ * compare-and-swap; a slot whose sequence equals the claimed position is
+ * free, and storing position + 1 into its sequence publishes the record to
+ * the writer. Returns SP_LOGGER_BUFFER_FULL if there is no free slot.
+ */
+static SP_LOGGER_MSG enqueueRecord(SPLoggerAsync async, SP_LOGGER_RECORD_TYPE type,
+		const char* msg, const char* file, const char* function, int line) {
+	size_t position = __atomic_load_n(&async->enqueuePosition, __ATOMIC_RELAXED);
+	Slot* slot;
+	for (;;) {
+		slot = &async->slots[position & async->mask];
+		size_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+		intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+		if (difference == 0) {
+			if (__atomic_compare_exchange_n(&async->enqueuePosition, &position,
+					position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+				break;
+			}
+		} else if (difference < 0) {
+			return SP_LOGGER_BUFFER_FULL;
+		} else {
+			position = __atomic_load_n(&async->enqueuePosition, __ATOMIC_RELAXED);
+		}
+	}
+
+	file = file ? file : "(null)";
+	function = function ? function : "";
+	size_t msgLength = strlen(msg) + 1;
+	size_t fileLength = strlen(file) + 1;
+	size_t functionLength = strlen(function) + 1;
+	size_t length = msgLength + fileLength + functionLength;
+	char* text = slot->text;
+	slot->heapText = NULL;
+	if (length > SP_LOGGER_SLOT_TEXT) { //Rare long records are copied to the heap
+		slot->heapText = (char*) malloc(length);
+		text = slot->heapText;
+	}
+	slot->type = type;
+	slot->line = line;
+	slot->fileOffset = -1; //Marks a record lost to an allocation failure
+	if (text != NULL) {
+		memcpy(text, msg, msgLength);
+		memcpy(text + msgLength, file, fileLength);
+		memcpy(text + msgLength + fileLength, function, functionLength);
+		slot->fileOffset = (int) msgLength;
+		slot->functionOffset = (int) (msgLength + fileLength);
+	}
+	__atomic_store_n(&slot->sequence, position + 1, __ATOMIC_RELEASE);
+
+	__atomic_thread_fence(__ATOMIC_SEQ_CST); //Order the publish before the check
+	if (__atomic_load_n(&async->writerSleeping, __ATOMIC_RELAXED)) {
+		wakeWriter(async);
+	}
+	return text != NULL ? SP_LOGGER_SUCCESS : SP_LOGGER_OUT_OF_MEMORY;
+}
+
+/*
+ * Reserves disk blocks for a log file of the size limit, without changing
+ * the size of the file, so the file does not grow block by block.
+ */
+static void preallocate(SPLoggerRotation rotation, int fd) {
+#ifdef FALLOC_FL_KEEP_SIZE
+	if (rotation->limits.maxBytes > 0) {
+		fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, (off_t) rotation->limits.maxBytes);
+	}
+#else
+	(void) rotation;
+	(void) fd;
+#endif
+}
+
+/*
+ * Creates and preallocates the file the logger switches to on its next
+ * rotation.
+ */
+static void prepareSpare(SPLoggerRotation rotation) {
+	rotation->spare = open(rotation->spareName, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if (rotation->spare >= 0) {
+		preallocate(rotation, rotation->spare);
+	}
+}
+
+/*
+ * Switches the logger to a new file: the rotated files are renamed to the
+ * next suffix (the last one is overwritten), the log file becomes
+ * filename.1 and the spare file becomes the log file. Then the next spare
+ * file is prepared. Runs on the writer thread.
+ */
+static void rotate(SPLogger owner) {
+	SPLoggerRotation rotation = owner->rotation;
+	size_t length = strlen(rotation->filename);
+	if (owner->outputChannel != NULL) {
+		fclose(owner->outputChannel);
 	}
-	logger = (SPLogger) malloc(sizeof(*logger));
-	if (logger == NULL) { //Allocation failure
+	for (int i = rotation->limits.fileCount - 1; i > 0; i--) {
+		strcpy(rotation->fromName, rotation->filename);
+		if (i > 1) {
+			sprintf(rotation->fromName + length, ".%d", i - 1);
+		}
+		sprintf(rotation->toName, "%s.%d", rotation->filename, i);
+		rename(rotation->fromName, rotation->toName);
+	}
+	if (rotation->spare >= 0 && rename(rotation->spareName, rotation->filename) == 0) {
+		owner->outputChannel = fdopen(rotation->spare, SP_LOGGER_OPEN_MODE);
+		if (owner->outputChannel == NULL) {
+			close(rotation->spare);
+		}
+	} else {
+		if (rotation->spare >= 0) {
+			close(rotation->spare);
+		}
+		owner->outputChannel = fopen(rotation->filename, SP_LOGGER_OPEN_MODE);
+	}
+	rotation->written = 0;
+	rotation->opened = time(NULL);
+	prepareSpare(rotation);
+}
+
+/*
+ * Writes a record on the writer thread, first rotating the file if it
+ * reached a limit. A file is never rotated while it is empty.
+ */
+static void writeOwnedRecord(SPLogger owner, SP_LOGGER_RECORD_TYPE type,
+		const char* msg, const char* file, const char* function, int line) {
+	SPLoggerRotation rotation = owner->rotation;
+	if (rotation == NULL) {
+		writeRecord(owner->outputChannel, type, msg, file, function, line, NULL);
+		return;
+	}
+	if (rotation->written > 0 &&
+			((rotation->limits.maxBytes > 0 && rotation->written >= rotation->limits.maxBytes) ||
+			(rotation->limits.maxSeconds > 0 &&
+			time(NULL) - rotation->opened >= rotation->limits.maxSeconds))) {
+		rotate(owner);
+	}
+	writeRecord(owner->outputChannel, type, msg, file, function, line, &rotation->written);
+}
+
+/*
+ * Writes and frees the next record of the ring. Returns false if the ring
+ * is empty.
+ */
+static bool dequeueRecord(SPLogger owner) {
+	SPLoggerAsync async = owner->async;
+	Slot* slot = &async->slots[async->dequeuePosition & async->mask];
+	if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != async->dequeuePosition + 1) {
+		return false;
+	}
+	const char* text = slot->heapText ? slot->heapText : slot->text;
+	if (slot->fileOffset >= 0) {
+		writeOwnedRecord(owner, slot->type, text, text + slot->fileOffset,
+				text + slot->functionOffset, slot->line);
+	}
+	free(slot->heapText);
+	__atomic_store_n(&slot->sequence, async->dequeuePosition + async->mask + 1,
+			__ATOMIC_RELEASE);
+	async->dequeuePosition++;
+	return true;
+}
+
+/*
+ * With the SP_LOGGER_OVERFLOW_COUNT policy, logs how many records were
+ * dropped since the last report.
+ */
+static void reportDropped(SPLogger owner) {
+	SPLoggerAsync async = owner->async;
+	unsigned long dropped = __atomic_load_n(&async->dropped, __ATOMIC_RELAXED);
+	char msg[64];
+	if (async->policy != SP_LOGGER_OVERFLOW_COUNT || dropped == async->reported) {
+		return;
+	}
+	sprintf(msg, "%lu log records were dropped", dropped - async->reported);
+	writeOwnedRecord(owner, SP_LOGGER_MSG_RECORD, msg, NULL, NULL, 0);
+	async->reported = dropped;
+}
+
+/*
+ * The writer thread: writes records until the logger is destroyed and the
+ * ring is empty. When the ring is empty the file is flushed and the writer
+ * sleeps until a print function wakes it (or a short timeout passes).
+ */
+static void* writerThread(void* argument) {
+	SPLogger owner = (SPLogger) argument;
+	SPLoggerAsync async = owner->async;
+	for (;;) {
+		reportDropped(owner);
+		if (dequeueRecord(owner)) {
+			continue;
+		}
+		if (__atomic_load_n(&async->stopping, __ATOMIC_ACQUIRE)) {
+			if (!dequeueRecord(owner)) { //Drained
+				reportDropped(owner);
+				break;
+			}
+			continue;
+		}
+		fflush(owner->outputChannel);
+		pthread_mutex_lock(&async->lock);
+		__atomic_store_n(&async->writerSleeping, true, __ATOMIC_SEQ_CST);
+		Slot* next = &async->slots[async->dequeuePosition & async->mask];
+		if (__atomic_load_n(&next->sequence, __ATOMIC_SEQ_CST) != async->dequeuePosition + 1 &&
+				!__atomic_load_n(&async->stopping, __ATOMIC_ACQUIRE)) {
+			struct timespec deadline;
+			clock_gettime(CLOCK_REALTIME, &deadline);
+			deadline.tv_nsec += SP_LOGGER_WRITER_IDLE_NS;
+			if (deadline.tv_nsec >= 1000000000L) {
+				deadline.tv_sec++;
+				deadline.tv_nsec -= 1000000000L;
+			}
+			pthread_cond_timedwait(&async->wakeUp, &async->lock, &deadline);
+		}
+		__atomic_store_n(&async->writerSleeping, false, __ATOMIC_RELAXED);
+		pthread_mutex_unlock(&async->lock);
+	}
+	fflush(owner->outputChannel);
+	return NULL;
+}
+
+/*
+ * Hands a record to the asynchronous writer, applying the overflow policy
+ * if the ring is full.
+ */
+static SP_LOGGER_MSG submitRecord(SPLoggerAsync async, SP_LOGGER_RECORD_TYPE type,
+		const char* msg, const char* file, const char* function, int line) {
+	SP_LOGGER_MSG result;
+	struct timespec wait = { 0, SP_LOGGER_PRODUCER_WAIT_NS };
+	while ((result = enqueueRecord(async, type, msg, file, function, line)) ==
+			SP_LOGGER_BUFFER_FULL && async->policy == SP_LOGGER_OVERFLOW_BLOCK) {
+		wakeWriter(async);
+		nanosleep(&wait, NULL);
+	}
+	if (result == SP_LOGGER_BUFFER_FULL) {
+		__atomic_add_fetch(&async->dropped, 1, __ATOMIC_RELAXED);
+	}
+	return result;
+}
+
+static size_t copyString(char* target, const char* string, size_t max) {
+	size_t length = strlen(string);
+	length = length < max ? length : max;
+	memcpy(target, string, length);
+	target[length] = '\0';
+	return length + 1;
+}
+
+/*
+ * Copies a record into the next slot of a flight recorder. The slot is
+ * claimed by a compare-and-swap of its sequence to SP_LOGGER_RECORDER_BUSY
+ * before the record is copied, and its sequence is set after it, so a record
+ * which a crash interrupted is recognized by the reader. If another thread
+ * is still copying into the slot, or a newer record already took it, the
+ * record is dropped and counted. Long strings are truncated to fit the slot.
+ */
+static SP_LOGGER_MSG recordFlight(SPLoggerRecorder recorder, SP_LOGGER_RECORD_TYPE type,
+		const char* msg, const char* file, const char* function, int line) {
+	uint64_t sequence = __atomic_fetch_add(&recorder->header->next, 1, __ATOMIC_RELAXED);
+	RecorderSlot* slot = &recorder->slots[sequence % recorder->header->slotCount];
+	uint64_t previous = __atomic_load_n(&slot->sequence, __ATOMIC_RELAXED);
+	if (previous == SP_LOGGER_RECORDER_BUSY || previous > sequence ||
+			!__atomic_compare_exchange_n(&slot->sequence, &previous, SP_LOGGER_RECORDER_BUSY,
+					false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) { //The slot is taken
+		__atomic_add_fetch(&recorder->dropped, 1, __ATOMIC_RELAXED);
+		return SP_LOGGER_BUFFER_FULL;
+	}
+	size_t fileOffset = copyString(slot->text, msg,
+			sizeof(slot->text) - 2 * (SP_LOGGER_RECORDER_NAME + 1) - 1);
+	size_t functionOffset = fileOffset + copyString(slot->text + fileOffset,
+			file ? file : "(null)", SP_LOGGER_RECORDER_NAME);
+	size_t length = functionOffset + copyString(slot->text + functionOffset,
+			function ? function : "", SP_LOGGER_RECORDER_NAME);
+	slot->fileOffset = (uint16_t) fileOffset;
+	slot->functionOffset = (uint16_t) functionOffset;
+	slot->length = (uint16_t) length;
+	slot->line = line;
+	slot->type = (uint8_t) type;
+	__atomic_store_n(&slot->sequence, sequence + 1, __ATOMIC_RELEASE);
+	return SP_LOGGER_SUCCESS;
+}
+
+/*
+ * Writes a record, or hands it to the writer thread of an asynchronous logger.
+ * site is the call site of the record, or NULL.
+ */
+static SP_LOGGER_MSG logRecord(SPLogger current, SPLoggerSite* site,
+		SP_LOGGER_RECORD_TYPE type, const char* msg, const char* file,
+		const char* function, int line) {
+	if (current->recorder != NULL) {
+		return recordFlight(current->recorder, type, msg, file, function, line);
+	}
+	if (current->serial != 0) {
+		return writeBinaryRecord(current, site, type, msg, file, function, line);
+	}
+	if (current->async != NULL) {
+		return submitRecord(current->async, type, msg, file, function, line);
+	}
+	return writeRecord(current->outputChannel, type, msg, file, function, line, NULL);
+}
+
+/*
+ * Returns the logger for the use of a print call, which must then call
+ * releaseLogger. Destroy unpublishes the logger before it waits for the
+ * active calls, so a call either finds the logger undefined or is waited for.
+ */
+static SPLogger acquireLogger() {
+	__atomic_add_fetch(&activeCalls, 1, __ATOMIC_SEQ_CST);
+	return __atomic_load_n(&logger, __ATOMIC_SEQ_CST);
+}
+
+static void releaseLogger() {
+	__atomic_sub_fetch(&activeCalls, 1, __ATOMIC_RELEASE);
+}
+
+static void destroyAsync(SPLoggerAsync async) {
+	pthread_mutex_destroy(&async->lock);
+	pthread_cond_destroy(&async->wakeUp);
+	free(async->slots);
+	free(async);
+}
+
+/*
+ * Allocates the ring of an asynchronous logger and starts its writer.
+ */
+static SP_LOGGER_MSG startAsync(SPLogger owner, int capacity,
+		SP_LOGGER_OVERFLOW_POLICY policy) {
+	size_t slots = 1;
+	while (slots < (size_t) capacity) { //Round up to a power of two
+		slots <<= 1;
+	}
+	SPLoggerAsync async = (SPLoggerAsync) malloc(sizeof(*async));
+	if (async == NULL) { //Allocation failure
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	async->slots = (Slot*) malloc(sizeof(Slot) * slots);
+	if (async->slots == NULL) { //Allocation failure
+		free(async);
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	for (size_t i = 0; i < slots; i++) {
+		async->slots[i].sequence = i;
+	}
+	async->mask = slots - 1;
+	async->enqueuePosition = 0;
+	async->dequeuePosition = 0;
+	async->policy = policy;
+	async->dropped = 0;
+	async->reported = 0;
+	async->stopping = false;
+	async->writerSleeping = false;
+	pthread_mutex_init(&async->lock, NULL);
+	pthread_cond_init(&async->wakeUp, NULL);
+	owner->async = async;
+	if (pthread_create(&async->writer, NULL, writerThread, owner) != 0) {
+		owner->async = NULL;
+		destroyAsync(async);
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	return SP_LOGGER_SUCCESS;
+}
+
+/*
+ * Waits until the writer has written every record, and stops it.
+ */
+static void stopAsync(SPLoggerAsync async) {
+	__atomic_store_n(&async->stopping, true, __ATOMIC_RELEASE);
+	wakeWriter(async);
+	pthread_join(async->writer, NULL);
+	destroyAsync(async);
+}
+
+/*
+ * Creates a logger which is not yet published in the global variable. The
+ * file is opened only if openFile is true; a flight recorder opens its file
+ * itself.
+ */
+static SP_LOGGER_MSG createLogger(const char* filename, SP_LOGGER_LEVEL level,
+		bool openFile, SPLogger* created) {
+	SPLogger newLogger = (SPLogger) malloc(sizeof(*newLogger));
+	if (newLogger == NULL) { //Allocation failure
 		return SP_LOGGER_OUT_OF_MEMORY;
 	}
-	logger->level = level; //Set the level of the logger
+	newLogger->level = level; //Set the level of the logger
+	newLogger->async = NULL;
+	newLogger->serial = 0;
+	newLogger->rotation = NULL;
+	newLogger->recorder = NULL;
 	if (filename == NULL) { //In case the filename is not set use stdout
-		logger->outputChannel = stdout;
-		logger->isStdOut = true;
+		newLogger->outputChannel = stdout;
+		newLogger->isStdOut = true;
+	} else if (!openFile) {
+		newLogger->outputChannel = NULL;
+		newLogger->isStdOut = false;
 	} else { //Otherwise open the file in write mode
-		logger->outputChannel = fopen(filename, SP_LOGGER_OPEN_MODE);
-		if (logger->outputChannel == NULL) { //Open failed
-			free(logger);
-			logger = NULL;
+		newLogger->outputChannel = fopen(filename, SP_LOGGER_OPEN_MODE);
+		if (newLogger->outputChannel == NULL) { //Open failed
+			free(newLogger);
 			return SP_LOGGER_CANNOT_OPEN_FILE;
 		}
-		logger->isStdOut = false;
+		newLogger->isStdOut = false;
 	}
+	*created = newLogger;
 	return SP_LOGGER_SUCCESS;
 }
 
+static void destroyRotation(SPLoggerRotation rotation) {
+	if (rotation->spare >= 0) { //The spare file is not needed anymore
+		close(rotation->spare);
+		unlink(rotation->spareName);
+	}
+	free(rotation->filename);
+	free(rotation->spareName);
+	free(rotation->fromName);
+	free(rotation->toName);
+	free(rotation);
+}
 
-void spLoggerDestroy() {
-	if (!logger) {
-		return;
+static void destroyLogger(SPLogger oldLogger) {
+	if (oldLogger->async) {//Write all pending records first
+		stopAsync(oldLogger->async);
+	}
+	if (!oldLogger->isStdOut && oldLogger->outputChannel) {//Close file only if not stdout
+		fclose(oldLogger->outputChannel);
+	}
+	if (oldLogger->rotation) {
+		destroyRotation(oldLogger->rotation);
 	}
-	if (!logger->isStdOut) {//Close file only if not stdout
-		fclose(logger->outputChannel);
+	if (oldLogger->recorder) {//The kernel writes the mapped records to the file
+		munmap(oldLogger->recorder->header, oldLogger->recorder->size);
+		free(oldLogger->recorder);
 	}
-	free(logger);//free allocation
-	logger = NULL;
+	free(oldLogger);//free allocation
 }
 
+/*
+ * Makes a new logger rotate its file at the given limits, and prepares the
+ * spare file of its first rotation.
+ */
+static SP_LOGGER_MSG startRotation(SPLogger newLogger, const char* filename,
+		const RotationLimits* limits) {
+	size_t length = strlen(filename);
+	SPLoggerRotation rotation = (SPLoggerRotation) malloc(sizeof(*rotation));
+	if (rotation == NULL) { //Allocation failure
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	rotation->limits = *limits;
+	rotation->filename = (char*) malloc(length + 1);
+	rotation->spareName = (char*) malloc(length + sizeof(SP_LOGGER_SPARE_SUFFIX));
+	rotation->fromName = (char*) malloc(length + SP_LOGGER_SUFFIX_LENGTH);
+	rotation->toName = (char*) malloc(length + SP_LOGGER_SUFFIX_LENGTH);
+	rotation->spare = -1;
+	rotation->written = 0;
+	rotation->opened = time(NULL);
+	newLogger->rotation = rotation;
+	if (!rotation->filename || !rotation->spareName || !rotation->fromName ||
+			!rotation->toName) { //Allocation failure
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	strcpy(rotation->filename, filename);
+	sprintf(rotation->spareName, "%s%s", filename, SP_LOGGER_SPARE_SUFFIX);
+	preallocate(rotation, fileno(newLogger->outputChannel));
+	prepareSpare(rotation);
+	return SP_LOGGER_SUCCESS;
+}
 
-SP_LOGGER_MSG spLoggerPrintError(const char* msg, const char* file,
-		const char* function, const int line){
+/*
+ * Makes a new logger binary: gives it a serial, which no site was described
+ * to yet, and writes the header of the file.
+ */
+static SP_LOGGER_MSG startBinary(SPLogger newLogger) {
+	newLogger->serial = ++lastSerial;
+	if (newLogger->serial == 0) { //Wrapped around, 0 marks a text logger
+		newLogger->serial = ++lastSerial;
+	}
+	if (fwrite(SP_LOGGER_BINARY_MAGIC, 1, SP_LOGGER_BINARY_MAGIC_LENGTH,
+			newLogger->outputChannel) != SP_LOGGER_BINARY_MAGIC_LENGTH) {
+		return SP_LOGGER_WRITE_FAIL;
+	}
+	return SP_LOGGER_SUCCESS;
+}
 
-	// Check valid arguments and logger defined
+/*
+ * Makes a new logger a flight recorder: an existing file, which may hold the
+ * records of a crashed process, is renamed with SP_LOGGER_PREVIOUS_SUFFIX.
+ * A new file is sized for the header and the slots and mapped into memory,
+ * where records are then copied.
+ */
+static SP_LOGGER_MSG startRecorder(SPLogger newLogger, const char* filename, int slots) {
+	char* previousName = (char*) malloc(strlen(filename) + sizeof(SP_LOGGER_PREVIOUS_SUFFIX));
+	if (previousName == NULL) { //Allocation failure
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	sprintf(previousName, "%s%s", filename, SP_LOGGER_PREVIOUS_SUFFIX);
+	bool kept = rename(filename, previousName) == 0 || errno == ENOENT;
+	free(previousName);
+	if (!kept) { //The existing file must not be overwritten
+		return SP_LOGGER_CANNOT_OPEN_FILE;
+	}
+	SPLoggerRecorder recorder = (SPLoggerRecorder) malloc(sizeof(*recorder));
+	if (recorder == NULL) { //Allocation failure
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	recorder->size = sizeof(RecorderHeader) + sizeof(RecorderSlot) * (size_t) slots;
+	int fd = open(filename, O_RDWR | O_CREAT, 0666);
+	if (fd < 0 || ftruncate(fd, (off_t) recorder->size) != 0) { //The file is zeroed
+		if (fd >= 0) {
+			close(fd);
+		}
+		free(recorder);
+		return SP_LOGGER_CANNOT_OPEN_FILE;
+	}
+	void* mapping = mmap(NULL, recorder->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED) {
+		free(recorder);
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	recorder->header = (RecorderHeader*) mapping;
+	recorder->slots = (RecorderSlot*) (recorder->header + 1);
+	memcpy(recorder->header->magic, SP_LOGGER_RECORDER_MAGIC, SP_LOGGER_BINARY_MAGIC_LENGTH);
+	recorder->header->slotSize = sizeof(RecorderSlot);
+	recorder->header->slotCount = (uint32_t) slots;
+	recorder->header->next = 0;
+	recorder->dropped = 0;
+	newLogger->recorder = recorder;
+	return SP_LOGGER_SUCCESS;
+}
 
-	if(!msg || !function || line < 0){
+/*
+ * Creates the logger, and sets it up as the options say.
+ */
+static SP_LOGGER_MSG publishLogger(const char* filename, SP_LOGGER_LEVEL level,
+		const LoggerOptions* options) {
+	SPLogger newLogger = NULL;
+	SP_LOGGER_MSG result = SP_LOGGER_DEFINED;
+	pthread_mutex_lock(&lifecycleLock);
+	if (logger == NULL) {
+		result = createLogger(filename, level, options->recorderSlots == 0, &newLogger);
+	}
+	if (result == SP_LOGGER_SUCCESS && options->binary) {
+		result = startBinary(newLogger);
+		if (result != SP_LOGGER_SUCCESS) {
+			destroyLogger(newLogger);
+		}
+	}
+	if (result == SP_LOGGER_SUCCESS && options->recorderSlots > 0) {
+		result = startRecorder(newLogger, filename, options->recorderSlots);
+		if (result != SP_LOGGER_SUCCESS) {
+			destroyLogger(newLogger);
+		}
+	}
+	if (result == SP_LOGGER_SUCCESS && options->limits != NULL) {
+		result = startRotation(newLogger, filename, options->limits);
+		if (result != SP_LOGGER_SUCCESS) {
+			destroyLogger(newLogger);
+		}
+	}
+	if (result == SP_LOGGER_SUCCESS && options->capacity > 0) {
+		result = startAsync(newLogger, options->capacity, options->policy);
+		if (result != SP_LOGGER_SUCCESS) {
+			destroyLogger(newLogger);
+		}
+	}
+	if (result == SP_LOGGER_SUCCESS) {
+		__atomic_store_n(&logger, newLogger, __ATOMIC_SEQ_CST);
+		__atomic_store_n(&spLoggerActiveLevel, (int) level, __ATOMIC_RELAXED);
+	}
+	pthread_mutex_unlock(&lifecycleLock);
+	return result;
+}
+
+SP_LOGGER_MSG spLoggerCreate(const char* filename, SP_LOGGER_LEVEL level) {
+	LoggerOptions options = { 0, SP_LOGGER_OVERFLOW_DROP, false, NULL, 0 };
+	return publishLogger(filename, level, &options);
+}
+
+SP_LOGGER_MSG spLoggerCreateBinary(const char* filename, SP_LOGGER_LEVEL level) {
+	LoggerOptions options = { 0, SP_LOGGER_OVERFLOW_DROP, true, NULL, 0 };
+	return publishLogger(filename, level, &options);
+}
+
+SP_LOGGER_MSG spLoggerCreateAsync(const char* filename, SP_LOGGER_LEVEL level,
+		int capacity, SP_LOGGER_OVERFLOW_POLICY policy) {
+	LoggerOptions options = { capacity, policy, false, NULL, 0 };
+	if (capacity < 1 || (policy != SP_LOGGER_OVERFLOW_DROP &&
+			policy != SP_LOGGER_OVERFLOW_BLOCK && policy != SP_LOGGER_OVERFLOW_COUNT)) {
 		return SP_LOGGER_INVAlID_ARGUMENT;
 	}
-	if(logger == NULL){
-		return SP_LOGGER_UNDIFINED;
+	return publishLogger(filename, level, &options);
+}
+
+SP_LOGGER_MSG spLoggerCreateRotating(const char* filename, SP_LOGGER_LEVEL level,
+		int capacity, SP_LOGGER_OVERFLOW_POLICY policy, long maxBytes, int maxSeconds,
+		int fileCount) {
+	RotationLimits limits = { maxBytes, maxSeconds, fileCount };
+	LoggerOptions options = { capacity, policy, false, &limits, 0 };
+	if (filename == NULL || capacity < 1 || (policy != SP_LOGGER_OVERFLOW_DROP &&
+			policy != SP_LOGGER_OVERFLOW_BLOCK && policy != SP_LOGGER_OVERFLOW_COUNT) ||
+			maxBytes < 0 || maxSeconds < 0 || (maxBytes == 0 && maxSeconds == 0) ||
+			fileCount < 1) {
+		return SP_LOGGER_INVAlID_ARGUMENT;
 	}
+	return publishLogger(filename, level, &options);
+}
 
-	// Write to file
-	if (logger->outputChannel == NULL) { //Open failed
-	 	return SP_LOGGER_WRITE_FAIL;
+SP_LOGGER_MSG spLoggerCreateFlightRecorder(const char* filename, SP_LOGGER_LEVEL level,
+		int capacity) {
+	LoggerOptions options = { 0, SP_LOGGER_OVERFLOW_DROP, false, NULL, capacity };
+	if (filename == NULL || capacity < 1) {
+		return SP_LOGGER_INVAlID_ARGUMENT;
 	}
-	else {
-			 fprintf(logger->outputChannel, "---ERROR---\n");
-			 fprintf(logger->outputChannel, "- file: %s\n",file);
-			 fprintf(logger->outputChannel, "- function: %s\n",function);
-			 fprintf(logger->outputChannel, "- line: %i\n",line);
-			 fprintf(logger->outputChannel, "- message: %s\n",msg);
-			 //fprintf(logger->outputChannel, "\n");
+	return publishLogger(filename, level, &options);
+}
 
+unsigned long spLoggerGetDroppedCount() {
+	unsigned long dropped = 0;
+	SPLogger current = acquireLogger();
+	if (current != NULL && current->async != NULL) {
+		dropped = __atomic_load_n(&current->async->dropped, __ATOMIC_RELAXED);
+	} else if (current != NULL && current->recorder != NULL) {
+		dropped = __atomic_load_n(&current->recorder->dropped, __ATOMIC_RELAXED);
+	}
+	releaseLogger();
+	return dropped;
+}
+
+void spLoggerDestroy() {
+	struct timespec wait = { 0, SP_LOGGER_PRODUCER_WAIT_NS };
+	pthread_mutex_lock(&lifecycleLock);
+	SPLogger oldLogger = logger;
+	if (oldLogger != NULL) {
+		__atomic_store_n(&spLoggerActiveLevel, -1, __ATOMIC_RELAXED);
+		__atomic_store_n(&logger, NULL, __ATOMIC_SEQ_CST);
+		while (__atomic_load_n(&activeCalls, __ATOMIC_ACQUIRE) != 0) { //Calls in progress
+			nanosleep(&wait, NULL);
+		}
+		destroyLogger(oldLogger);
+	}
+	pthread_mutex_unlock(&lifecycleLock);
+}
+
+
+static SP_LOGGER_MSG printError(const char* msg, const char* file,
+		const char* function, const int line, SPLogger current){
+
+	// Check valid arguments and logger defined
+
+	if(!msg || !function || line < 0){
+		return SP_LOGGER_INVAlID_ARGUMENT;
+	}
+	if(current == NULL){
+		return SP_LOGGER_UNDIFINED;
 	}
-	return SP_LOGGER_SUCCESS;
+
+	return logRecord(current, NULL, SP_LOGGER_ERROR_RECORD, msg, file, function, line);
 
 }
 
 
-SP_LOGGER_MSG spLoggerPrintWarning(const char* msg, const char* file,
-		const char* function, const int line){
+static SP_LOGGER_MSG printWarning(const char* msg, const char* file,
+		const char* function, const int line, SPLogger current){
 
 
 
@@ -93,108 +1051,478 @@ SP_LOGGER_MSG spLoggerPrintWarning(const char* msg, const char* file,
 	if(!msg || !function || line < 0){
 	 return SP_LOGGER_INVAlID_ARGUMENT;
 	}
-	if(logger == NULL){
+	if(current == NULL){
 		return SP_LOGGER_UNDIFINED;
 	}
 
 	// Check valid level
-		if(logger->level == SP_LOGGER_ERROR_LEVEL){
+		if(current->level == SP_LOGGER_ERROR_LEVEL){
 			return SP_LOGGER_SUCCESS;
 		}
 
 		else {
 
-			// Write to file
-			if (logger->outputChannel == NULL) { //Open failed
-				return SP_LOGGER_WRITE_FAIL;
-			}
-			else {
-					 fprintf(logger->outputChannel, "---WARNING---\n");
-					 fprintf(logger->outputChannel, "- file: %s\n",file);
-					 fprintf(logger->outputChannel, "- function: %s\n",function);
-					 fprintf(logger->outputChannel, "- line: %i\n",line);
-					 fprintf(logger->outputChannel, "- message: %s\n",msg);
-					 //fprintf(logger->outputChannel, "\n");
-
-			}
+			return logRecord(current, NULL, SP_LOGGER_WARNING_RECORD, msg, file, function, line);
 		}
-	return SP_LOGGER_SUCCESS;
 }
 
-SP_LOGGER_MSG spLoggerPrintDebug(const char* msg, const char* file,
-		const char* function, const int line){
+static SP_LOGGER_MSG printDebug(const char* msg, const char* file,
+		const char* function, const int line, SPLogger current){
 
 	// Check valid arguments and logger defined
 	if(!msg || !function || line < 0){
 	 return SP_LOGGER_INVAlID_ARGUMENT;
 	}
-	if(logger == NULL){
+	if(current == NULL){
 		return SP_LOGGER_UNDIFINED;
 	}
 
 	// Check valid level
-	if(logger->level == SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL){
+	if(current->level == SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL){
 
-		// Write to file
-			if (logger->outputChannel == NULL) { //Open failed
-			 	return SP_LOGGER_WRITE_FAIL;
-			}
-			else {
-					 fprintf(logger->outputChannel, "---DEBUG---\n");
-					 fprintf(logger->outputChannel, "- file: %s\n",file);
-					 fprintf(logger->outputChannel, "- function: %s\n",function);
-					 fprintf(logger->outputChannel, "- line: %i\n",line);
-					 fprintf(logger->outputChannel, "- message: %s\n",msg);
-					 //fprintf(logger->outputChannel, "\n");
-
-			}
+		return logRecord(current, NULL, SP_LOGGER_DEBUG_RECORD, msg, file, function, line);
 	}
 	return SP_LOGGER_SUCCESS;
 }
 
-SP_LOGGER_MSG spLoggerPrintInfo(const char* msg){
+static SP_LOGGER_MSG printInfo(const char* msg, SPLogger current){
 	// Check valid arguments and logger defined
 		if(!msg){
 		 return SP_LOGGER_INVAlID_ARGUMENT;
 		}
-		if(logger == NULL){
+		if(current == NULL){
 			return SP_LOGGER_UNDIFINED;
 		}
 
 		// Check valid level
-		if(logger->level == SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL ||
-				logger->level == SP_LOGGER_INFO_WARNING_ERROR_LEVEL){
+		if(current->level == SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL ||
+				current->level == SP_LOGGER_INFO_WARNING_ERROR_LEVEL){
 
-			// Write to file
-				if (logger->outputChannel == NULL) { //Open failed
-				 	return SP_LOGGER_WRITE_FAIL;
-				}
-				else {
-						 fprintf(logger->outputChannel, "---INFO---\n");
-						 fprintf(logger->outputChannel, "- message: %s\n",msg);
-						 //fprintf(logger->outputChannel, "\n");
-
-				}
+			return logRecord(current, NULL, SP_LOGGER_INFO_RECORD, msg, NULL, NULL, 0);
 		}
 		return SP_LOGGER_SUCCESS;
 }
 
-SP_LOGGER_MSG spLoggerPrintMsg(const char* msg){
+static SP_LOGGER_MSG printMsg(const char* msg, SPLogger current){
 	// Check valid arguments and logger defined
 			if(!msg){
 			 return SP_LOGGER_INVAlID_ARGUMENT;
 			}
-			if(logger == NULL){
+			if(current == NULL){
 				return SP_LOGGER_UNDIFINED;
 			}
 
-			if (logger->outputChannel == NULL) { //Open failed
-				return SP_LOGGER_WRITE_FAIL;
+			return logRecord(current, NULL, SP_LOGGER_MSG_RECORD, msg, NULL, NULL, 0);
+}
+
+SP_LOGGER_MSG spLoggerPrintError(const char* msg, const char* file,
+		const char* function, const int line) {
+	SPLogger current = acquireLogger();
+	SP_LOGGER_MSG result = printError(msg, file, function, line, current);
+	releaseLogger();
+	return result;
+}
+
+SP_LOGGER_MSG spLoggerPrintWarning(const char* msg, const char* file,
+		const char* function, const int line) {
+	SPLogger current = acquireLogger();
+	SP_LOGGER_MSG result = printWarning(msg, file, function, line, current);
+	releaseLogger();
+	return result;
+}
+
+SP_LOGGER_MSG spLoggerPrintDebug(const char* msg, const char* file,
+		const char* function, const int line) {
+	SPLogger current = acquireLogger();
+	SP_LOGGER_MSG result = printDebug(msg, file, function, line, current);
+	releaseLogger();
+	return result;
+}
+
+SP_LOGGER_MSG spLoggerPrintInfo(const char* msg) {
+	SPLogger current = acquireLogger();
+	SP_LOGGER_MSG result = printInfo(msg, current);
+	releaseLogger();
+	return result;
+}
+
+SP_LOGGER_MSG spLoggerPrintMsg(const char* msg) {
+	SPLogger current = acquireLogger();
+	SP_LOGGER_MSG result = printMsg(msg, current);
+	releaseLogger();
+	return result;
+}
+
+/*
+ * Prints the number of suppressed records of a site, unless it is 0 or was
+ * printed less than SP_LOGGER_SUMMARY_SECONDS ago. The thread which
+ * advances the time of the last report prints the count.
+ */
+static void reportSuppressed(SPLogger current, SPLoggerSite* site) {
+	char msg[80];
+	if (__atomic_load_n(&site->suppressed, __ATOMIC_RELAXED) == 0) {
+		return;
+	}
+	long now = (long) time(NULL);
+	long reported = __atomic_load_n(&site->reported, __ATOMIC_RELAXED);
+	if (now - reported < SP_LOGGER_SUMMARY_SECONDS ||
+			!__atomic_compare_exchange_n(&site->reported, &reported, now, false,
+					__ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+		return;
+	}
+	unsigned long suppressed = __atomic_exchange_n(&site->suppressed, 0, __ATOMIC_RELAXED);
+	if (suppressed > 0) {
+		sprintf(msg, "%lu log records of this call site were suppressed", suppressed);
+		logRecord(current, site, site->type, msg, site->file, site->function, site->line);
+	}
+}
+
+SP_LOGGER_MSG spLoggerPrintSite(SPLoggerSite* site, const char* msg) {
+	return spLoggerPrintSiteSuppressed(site, msg, 0);
+}
+
+SP_LOGGER_MSG spLoggerPrintSiteSuppressed(SPLoggerSite* site, const char* msg,
+		unsigned long suppressed) {
+	static const SP_LOGGER_LEVEL levels[] = { SP_LOGGER_ERROR_LEVEL,
+			SP_LOGGER_WARNING_ERROR_LEVEL, SP_LOGGER_INFO_WARNING_ERROR_LEVEL,
+			SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL, SP_LOGGER_ERROR_LEVEL };
+	if (!site || !msg || site->type < SP_LOGGER_ERROR_RECORD ||
+			site->type > SP_LOGGER_MSG_RECORD || site->line < 0 ||
+			(site->type != SP_LOGGER_INFO_RECORD && site->type != SP_LOGGER_MSG_RECORD &&
+			!site->function)) {
+		return SP_LOGGER_INVAlID_ARGUMENT;
+	}
+	SPLogger current = acquireLogger();
+	SP_LOGGER_MSG result = SP_LOGGER_UNDIFINED;
+	if (current != NULL) {
+		result = SP_LOGGER_SUCCESS;
+		if (current->level >= levels[site->type]) {
+			if (suppressed > 0) {
+				__atomic_add_fetch(&site->suppressed, suppressed, __ATOMIC_RELAXED);
+			}
+			reportSuppressed(current, site);
+			result = logRecord(current, site, site->type, msg, site->file,
+					site->function, site->line);
+		}
+	}
+	releaseLogger();
+	return result;
+}
+
+bool spLoggerTakeToken(SPLoggerBucket* bucket, double perSecond, double burst) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	double seconds = (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+	if (bucket->refilled == 0) { //A zeroed bucket starts full
+		bucket->tokens = burst;
+	} else {
+		bucket->tokens += (seconds - bucket->refilled) * perSecond;
+	}
+	if (bucket->tokens > burst) {
+		bucket->tokens = burst;
+	}
+	bucket->refilled = seconds;
+	if (bucket->tokens < 1) {
+		return false;
+	}
+	bucket->tokens -= 1;
+	return true;
+}
+
+static SP_LOGGER_MSG readBytes(FILE* in, void* data, size_t size) {
+	return fread(data, 1, size, in) == size ? SP_LOGGER_SUCCESS : SP_LOGGER_INVAlID_ARGUMENT;
+}
+
+/*
+ * Reads a string of a file of the given size. A string longer than the rest
+ * of the file is cut off, like a short read, and is not allocated.
+ */
+static SP_LOGGER_MSG readString(FILE* in, long size, char** string) {
+	uint32_t length;
+	SP_LOGGER_MSG result = readBytes(in, &length, sizeof(length));
+	if (result != SP_LOGGER_SUCCESS) {
+		return result;
+	}
+	if ((long long) length > (long long) size - ftell(in)) {
+		return SP_LOGGER_INVAlID_ARGUMENT;
+	}
+	*string = (char*) malloc((size_t) length + 1);
+	if (*string == NULL) { //Allocation failure
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	(*string)[length] = '\0';
+	return readBytes(in, *string, length);
+}
+
+static void freeBinaryRecord(BinaryRecord* record) {
+	free(record->file);
+	free(record->function);
+	free(record->msg);
+	record->file = NULL;
+	record->function = NULL;
+	record->msg = NULL;
+}
+
+/*
+ * Reads the next record of a binary log of the given size. Sets end to true
+ * if there are no more records; an incomplete last record, as left by a
+ * process which was killed, also ends the log. The strings of the record
+ * must be freed with freeBinaryRecord, also if reading failed.
+ */
+static SP_LOGGER_MSG readBinaryRecord(FILE* in, long size, BinaryRecord* record,
+		bool* end) {
+	uint8_t tag;
+	SP_LOGGER_MSG result = SP_LOGGER_SUCCESS;
+	record->file = NULL;
+	record->function = NULL;
+	record->msg = NULL;
+	*end = fread(&tag, 1, 1, in) != 1;
+	if (*end) {
+		return ferror(in) ? SP_LOGGER_INVAlID_ARGUMENT : SP_LOGGER_SUCCESS;
+	}
+	record->tag = (SP_LOGGER_BINARY_TAG) tag;
+	switch (record->tag) {
+	case SP_LOGGER_SITE_TAG:
+		result = readBytes(in, &record->id, sizeof(record->id));
+		result = result == SP_LOGGER_SUCCESS ? readBytes(in, &record->type, 1) : result;
+		result = result == SP_LOGGER_SUCCESS ?
+				readBytes(in, &record->line, sizeof(record->line)) : result;
+		result = result == SP_LOGGER_SUCCESS ? readString(in, size, &record->file) : result;
+		result = result == SP_LOGGER_SUCCESS ? readString(in, size, &record->function) : result;
+		break;
+	case SP_LOGGER_EVENT_TAG:
+		result = readBytes(in, &record->id, sizeof(record->id));
+		result = result == SP_LOGGER_SUCCESS ?
+				readBytes(in, &record->time, sizeof(record->time)) : result;
+		result = result == SP_LOGGER_SUCCESS ? readString(in, size, &record->msg) : result;
+		break;
+	case SP_LOGGER_FULL_TAG:
+		result = readBytes(in, &record->type, 1);
+		result = result == SP_LOGGER_SUCCESS ?
+				readBytes(in, &record->time, sizeof(record->time)) : result;
+		result = result == SP_LOGGER_SUCCESS ?
+				readBytes(in, &record->line, sizeof(record->line)) : result;
+		result = result == SP_LOGGER_SUCCESS ? readString(in, size, &record->file) : result;
+		result = result == SP_LOGGER_SUCCESS ? readString(in, size, &record->function) : result;
+		result = result == SP_LOGGER_SUCCESS ? readString(in, size, &record->msg) : result;
+		break;
+	default: //Unknown tag
+		return SP_LOGGER_INVAlID_ARGUMENT;
+	}
+	if (result == SP_LOGGER_INVAlID_ARGUMENT && !ferror(in)) { //Cut off by the end of the file
+		*end = true;
+		result = SP_LOGGER_SUCCESS;
+	}
+	return result;
+}
+
+static int compareSiteIds(const void* first, const void* second) {
+	uint32_t id1 = ((const BinaryRecord*) first)->id;
+	uint32_t id2 = ((const BinaryRecord*) second)->id;
+	return (id1 > id2) - (id1 < id2);
+}
+
+/*
+ * Reads the descriptions of the sites of a binary log into sites, sorted by
+ * the site ids. The file is read from its current position to its end.
+ */
+static SP_LOGGER_MSG readSites(FILE* in, long size, BinaryRecord** sites,
+		size_t* count) {
+	BinaryRecord record;
+	bool end = false;
+	size_t capacity = *count;
+	SP_LOGGER_MSG result = SP_LOGGER_SUCCESS;
+	while (result == SP_LOGGER_SUCCESS) {
+		result = readBinaryRecord(in, size, &record, &end);
+		if (result != SP_LOGGER_SUCCESS || end || record.tag != SP_LOGGER_SITE_TAG ||
+				record.type > SP_LOGGER_MSG_RECORD) {
+			freeBinaryRecord(&record);
+			if (end) {
+				break;
+			}
+			continue;
+		}
+		if (record.id == 0 || record.id > (uint32_t) INT_MAX) { //Not an id the writer assigns
+			freeBinaryRecord(&record);
+			return SP_LOGGER_INVAlID_ARGUMENT;
+		}
+		if (*count == capacity) { //Grow the table
+			size_t newCapacity = capacity == 0 ? 16 : capacity * 2;
+			BinaryRecord* grown = (BinaryRecord*) realloc(*sites,
+					sizeof(BinaryRecord) * newCapacity);
+			if (grown == NULL) { //Allocation failure
+				freeBinaryRecord(&record);
+				return SP_LOGGER_OUT_OF_MEMORY;
 			}
-			else {
-				fprintf(logger->outputChannel, "- message: %s\n",msg);
-				//fprintf(logger->outputChannel, "\n");
+			*sites = grown;
+			capacity = newCapacity;
+		}
+		(*sites)[(*count)++] = record;
+	}
+	if (*count > 0) {
+		qsort(*sites, *count, sizeof(BinaryRecord), compareSiteIds);
+	}
+	return result;
+}
 
+/*
+ * Writes the records of a binary log, from the current position of the file
+ * to its end, in the text format. A record of a site that was never described,
+ * because the write of its description failed, is written as an error of an
+ * unknown site.
+ */
+static SP_LOGGER_MSG renderRecords(FILE* in, long size, FILE* out,
+		BinaryRecord* sites, size_t count) {
+	BinaryRecord record;
+	bool end = false;
+	SP_LOGGER_MSG result = SP_LOGGER_SUCCESS;
+	while (result == SP_LOGGER_SUCCESS) {
+		result = readBinaryRecord(in, size, &record, &end);
+		if (result == SP_LOGGER_SUCCESS && !end && record.tag == SP_LOGGER_FULL_TAG &&
+				record.type <= SP_LOGGER_MSG_RECORD) {
+			result = writeRecord(out, (SP_LOGGER_RECORD_TYPE) record.type, record.msg,
+					record.file, record.function, record.line, NULL);
+		} else if (result == SP_LOGGER_SUCCESS && !end && record.tag == SP_LOGGER_EVENT_TAG) {
+			BinaryRecord* site = count == 0 ? NULL : (BinaryRecord*) bsearch(&record,
+					sites, count, sizeof(BinaryRecord), compareSiteIds);
+			if (site == NULL) { //The site was never described
+				char file[SP_LOGGER_UNKNOWN_SITE_LENGTH];
+				sprintf(file, "(unknown site %lu)", (unsigned long) record.id);
+				result = writeRecord(out, SP_LOGGER_ERROR_RECORD, record.msg, file,
+						"(unknown)", 0, NULL);
+			} else {
+				result = writeRecord(out, (SP_LOGGER_RECORD_TYPE) site->type, record.msg,
+						site->file, site->function, site->line, NULL);
 			}
-			return SP_LOGGER_SUCCESS;
+		}
+		freeBinaryRecord(&record);
+		if (end) {
+			break;
+		}
+	}
+	return result;
+}
+
+/*
+ * Reads the slots of a flight recorder file of the given size, whose magic
+ * was already read. The header must describe exactly the slots in the file,
+ * so a damaged header cannot make the reader allocate more than the file.
+ */
+static SP_LOGGER_MSG readRecorder(FILE* in, long size, RecorderSlot** slots,
+		uint32_t* count) {
+	RecorderHeader header;
+	SP_LOGGER_MSG result = readBytes(in, &header.slotSize,
+			sizeof(header) - SP_LOGGER_BINARY_MAGIC_LENGTH);
+	if (result != SP_LOGGER_SUCCESS || header.slotSize != sizeof(RecorderSlot) ||
+			header.slotCount == 0 || (uint64_t) header.slotCount * sizeof(RecorderSlot) !=
+			(uint64_t) size - sizeof(header)) {
+		return SP_LOGGER_INVAlID_ARGUMENT;
+	}
+	*slots = (RecorderSlot*) malloc(sizeof(RecorderSlot) * header.slotCount);
+	if (*slots == NULL) { //Allocation failure
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	*count = header.slotCount;
+	return readBytes(in, *slots, sizeof(RecorderSlot) * header.slotCount);
+}
+
+static int compareSequences(const void* first, const void* second) {
+	uint64_t sequence1 = (*(const RecorderSlot* const*) first)->sequence;
+	uint64_t sequence2 = (*(const RecorderSlot* const*) second)->sequence;
+	return (sequence1 > sequence2) - (sequence1 < sequence2);
+}
+
+/*
+ * Decides whether a slot holds a complete record: its sequence is set and
+ * not busy, it
+ * is in the slot of its sequence, and its strings are terminated.
+ */
+static bool isRecorded(const RecorderSlot* slot, uint32_t index, uint32_t count) {
+	return slot->sequence != 0 && slot->sequence != SP_LOGGER_RECORDER_BUSY &&
+			(slot->sequence - 1) % count == index &&
+			slot->type <= SP_LOGGER_MSG_RECORD && slot->length <= sizeof(slot->text) &&
+			slot->fileOffset > 0 && slot->fileOffset < slot->functionOffset &&
+			slot->functionOffset < slot->length && slot->text[slot->fileOffset - 1] == '\0' &&
+			slot->text[slot->functionOffset - 1] == '\0' &&
+			slot->text[slot->length - 1] == '\0';
+}
+
+/*
+ * Writes the complete records of a flight recorder in the order of their
+ * sequence numbers, in the text format.
+ */
+static SP_LOGGER_MSG renderRecorder(FILE* out, RecorderSlot* slots, uint32_t count) {
+	SP_LOGGER_MSG result = SP_LOGGER_SUCCESS;
+	const RecorderSlot** records = (const RecorderSlot**) malloc(sizeof(RecorderSlot*) * count);
+	uint32_t recorded = 0;
+	if (records == NULL) { //Allocation failure
+		return SP_LOGGER_OUT_OF_MEMORY;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		if (isRecorded(&slots[i], i, count)) {
+			records[recorded++] = &slots[i];
+		}
+	}
+	qsort(records, recorded, sizeof(RecorderSlot*), compareSequences);
+	for (uint32_t i = 0; i < recorded && result == SP_LOGGER_SUCCESS; i++) {
+		result = writeRecord(out, (SP_LOGGER_RECORD_TYPE) records[i]->type,
+				records[i]->text, records[i]->text + records[i]->fileOffset,
+				records[i]->text + records[i]->functionOffset, records[i]->line, NULL);
+	}
+	free(records);
+	return result;
+}
+
+SP_LOGGER_MSG spLoggerDecode(const char* binaryFilename, const char* textFilename) {
+	char magic[SP_LOGGER_BINARY_MAGIC_LENGTH];
+	BinaryRecord* sites = NULL;
+	size_t siteCount = 0;
+	RecorderSlot* slots = NULL;
+	uint32_t slotCount = 0;
+	bool recorder = false;
+	if (binaryFilename == NULL) {
+		return SP_LOGGER_INVAlID_ARGUMENT;
+	}
+	FILE* in = fopen(binaryFilename, "rb");
+	if (in == NULL) { //Open failed
+		return SP_LOGGER_CANNOT_OPEN_FILE;
+	}
+	long size = fseek(in, 0, SEEK_END) == 0 ? ftell(in) : -1;
+	SP_LOGGER_MSG result = size >= 0 && fseek(in, 0, SEEK_SET) == 0 ?
+			readBytes(in, magic, sizeof(magic)) : SP_LOGGER_INVAlID_ARGUMENT;
+	if (result == SP_LOGGER_SUCCESS) {
+		recorder = memcmp(magic, SP_LOGGER_RECORDER_MAGIC, sizeof(magic)) == 0;
+		if (!recorder && memcmp(magic, SP_LOGGER_BINARY_MAGIC, sizeof(magic)) != 0) {
+			result = SP_LOGGER_INVAlID_ARGUMENT;
+		}
+	}
+	if (result == SP_LOGGER_SUCCESS) {
+		result = recorder ? readRecorder(in, size, &slots, &slotCount) :
+				readSites(in, size, &sites, &siteCount);
+	}
+	FILE* out = NULL;
+	if (result == SP_LOGGER_SUCCESS) {
+		out = textFilename ? fopen(textFilename, SP_LOGGER_OPEN_MODE) : stdout;
+		result = out == NULL ? SP_LOGGER_CANNOT_OPEN_FILE : SP_LOGGER_SUCCESS;
+	}
+	if (result == SP_LOGGER_SUCCESS && recorder) {
+		result = renderRecorder(out, slots, slotCount);
+	} else if (result == SP_LOGGER_SUCCESS) { //Second pass, with all the sites known
+		result = fseek(in, SP_LOGGER_BINARY_MAGIC_LENGTH, SEEK_SET) == 0 ?
+				renderRecords(in, size, out, sites, siteCount) : SP_LOGGER_INVAlID_ARGUMENT;
+	}
+	if (out != NULL && out != stdout) {
+		if (fclose(out) != 0 && result == SP_LOGGER_SUCCESS) {
+			result = SP_LOGGER_WRITE_FAIL;
+		}
+	} else if (out != NULL) {
+		fflush(out);
+	}
+	for (size_t i = 0; i < siteCount; i++) {
+		freeBinaryRecord(&sites[i]);
+	}
+	free(sites);
+	free(slots);
+	fclose(in);
+	return result;
 }
@@ -1,5 +1,6 @@
 #ifndef SPLOGGER_H_
 #define SPLOGGER_H_
+#include <stdbool.h>
 /**
  * SP Logger summary:
  * SP Logger is defined at compilation time and it must be initialized
@@ -14,16 +15,77 @@
  * The logger supports another printing function which can be called at any level
  * The user must destroy the logger at end of usage
  *	
+ * All the functions may be called concurrently from several threads. Each
+ * record is written with a single write to the log file, so the records of
+ * concurrent threads never interleave. Print functions which run while the
+ * logger is destroyed either complete first or find the logger undefined.
+ *
+ * An asynchronous logger (see spLoggerCreateAsync) does not write records on
+ * the calling thread. The print functions copy their record into a
+ * preallocated ring buffer without taking any lock, and a background writer
+ * thread formats the records and writes them in order. spLoggerDestroy
+ * writes all pending records before it returns.
+ *
+ * A rotating logger (see spLoggerCreateRotating) is an asynchronous logger
+ * whose writer thread switches to a new file when the log file reaches a size
+ * or an age, keeping a bounded number of older files. The file the writer
+ * switches to is created and preallocated in advance, so neither the print
+ * functions nor the writer wait for the file system to grow the file.
+ *
+ * A flight recorder (see spLoggerCreateFlightRecorder) keeps the last records
+ * in a fixed size file which is mapped into memory. A record is copied into
+ * the next slot of the file, with a sequence number, without a system call;
+ * the kernel writes the file even if the process crashes. spLoggerDecode
+ * renders the records left in the file in order.
+ *
+ * A binary logger (see spLoggerCreateBinary) writes compact binary records
+ * instead of text. Each call site of the SP_LOG_* macros holds a static
+ * descriptor with its kind, file, function and line, which is written to
+ * the log once; after that each record of the site holds only the site's
+ * id, a timestamp and the message. spLoggerDecode (and the splog-decode
+ * tool, see SPLogDecode.c) renders a binary log in the text format below.
+ *
  * The following functions are supported:
  * spLoggerCreate 		- Creates and initializes the logger
+ * spLoggerCreateAsync	- Creates and initializes an asynchronous logger
+ * spLoggerCreateRotating - Creates and initializes an asynchronous logger which rotates its file
+ * spLoggerCreateBinary	- Creates and initializes a binary logger
+ * spLoggerCreateFlightRecorder - Creates and initializes a memory mapped flight recorder
+ * spLoggerGetDroppedCount - Returns the number of records an asynchronous logger or a flight recorder dropped
+ * spLoggerDecode		- Renders a binary log or a flight recorder in the text format
  * spLoggerDestroy		- Closes are frees all resources of the logger
  * spLoggerPrintError   - Prints error messages at leves {Error, Warning, Info, Debug}
  * spLoggerPrintWarning - Prints warnning messages at levels {Warning, Info, Debug}
  * spLoggerPrintInfo    - Prints info messages at levels {Info, Debug}
  * spLoggerPrintDebug   - Prints debug messages at level {Debug}
  * spLoggerPrintMsg     - Prints the exact message at any level (Without formatting)
+ * spLoggerPrintSite	- Prints a message of a call site described by an SPLoggerSite
+ *
+ * The macros SP_LOG_ERROR, SP_LOG_WARNING, SP_LOG_INFO, SP_LOG_DEBUG and
+ * SP_LOG_MSG print a record with the current file, function and line,
+ * through a static SPLoggerSite. Before making the call they check the logger's level with a
+ * single load of a global variable, so a filtered record costs no call and
+ * its message is not evaluated. Records above SP_LOGGER_COMPILE_LEVEL are
+ * removed at compile time (see below).
+ *
+ * SP_LOG_EVERY and SP_LOG_LIMITED print only some of the records of a call
+ * site: one in every n records, or as many as a token bucket allows. The
+ * decision is taken in the calling thread from thread local state of the
+ * site, so each thread samples and limits a site separately. The number of
+ * records a site suppressed is printed, at most once a second, as a record
+ * of the site before its next printed record.
  */
 
+/**
+ * The most verbose level whose macros are compiled, as a number: 0 for
+ * error, 1 for warning, 2 for info and 3 for debug. For example, building
+ * with -DSP_LOGGER_COMPILE_LEVEL=1 removes every SP_LOG_INFO and SP_LOG_DEBUG.
+ * SP_LOG_ERROR and SP_LOG_MSG are always compiled.
+ */
+#ifndef SP_LOGGER_COMPILE_LEVEL
+#define SP_LOGGER_COMPILE_LEVEL 3
+#endif
+
 /** A type used to decide the level of the logger**/
 typedef enum sp_logger_level_t {
 	SP_LOGGER_ERROR_LEVEL, //Error level
@@ -40,9 +102,47 @@ typedef enum sp_logger_msg_t {
 	SP_LOGGER_UNDIFINED,
 	SP_LOGGER_DEFINED,
 	SP_LOGGER_WRITE_FAIL,
-	SP_LOGGER_SUCCESS
+	SP_LOGGER_SUCCESS,
+	SP_LOGGER_BUFFER_FULL
 } SP_LOGGER_MSG;
 
+/** A type used to decide what an asynchronous logger does when its buffer is full **/
+typedef enum sp_logger_overflow_policy_t {
+	SP_LOGGER_OVERFLOW_DROP, //The record is dropped
+	SP_LOGGER_OVERFLOW_BLOCK, //The print function waits until the writer makes room
+	SP_LOGGER_OVERFLOW_COUNT //The record is dropped, and the writer logs how many were dropped
+} SP_LOGGER_OVERFLOW_POLICY;
+
+/** The kinds of records, one per print function **/
+typedef enum sp_logger_record_type_t {
+	SP_LOGGER_ERROR_RECORD,
+	SP_LOGGER_WARNING_RECORD,
+	SP_LOGGER_INFO_RECORD,
+	SP_LOGGER_DEBUG_RECORD,
+	SP_LOGGER_MSG_RECORD
+} SP_LOGGER_RECORD_TYPE;
+
+/**
+ * Describes a call site. The SP_LOG_* macros keep one static site per call,
+ * the print functions fill id and serial.
+ */
+typedef struct sp_logger_site_t {
+	SP_LOGGER_RECORD_TYPE type;
+	const char* file;
+	const char* function;
+	int line;
+	int id; //Assigned when the site first prints, 0 before
+	unsigned int serial; //The binary logger the site was last described to
+	unsigned long suppressed; //Suppressed records not reported yet
+	long reported; //When suppressed records were last reported, in seconds
+} SPLoggerSite;
+
+/** The token bucket of a rate limited call site in one thread **/
+typedef struct sp_logger_bucket_t {
+	double tokens;
+	double refilled; //When tokens were last added, in seconds
+} SPLoggerBucket;
+
 /** A type used for defining the logger**/
 typedef struct sp_logger_t* SPLogger;
 
@@ -63,9 +163,164 @@ typedef struct sp_logger_t* SPLogger;
  */
 SP_LOGGER_MSG spLoggerCreate(const char* filename, SP_LOGGER_LEVEL level);
 
+/**
+ * Creates an asynchronous logger. Same as spLoggerCreate, except that records
+ * are written by a background thread. The print functions copy their record
+ * into a buffer of capacity records, and return without waiting for the
+ * write. When the buffer is full, a print function follows the given policy:
+ *
+ * SP_LOGGER_OVERFLOW_DROP	- The record is dropped and SP_LOGGER_BUFFER_FULL
+ * 							  is returned
+ * SP_LOGGER_OVERFLOW_BLOCK	- The print function waits until there is room
+ * SP_LOGGER_OVERFLOW_COUNT	- The record is dropped and SP_LOGGER_BUFFER_FULL is
+ * 							  returned. The writer then logs a message saying
+ * 							  how many records were dropped, in the format of
+ * 							  spLoggerPrintMsg.
+ *
+ * Write failures are not reported to the print functions.
+ *
+ * @param filename - The name of the log file, if not specified stdout is used
+ * 					 as default.
+ * @param level - The level of the logger prints
+ * @param capacity - The number of records the buffer holds (rounded up to a
+ * 					 power of two)
+ * @param policy - What print functions do when the buffer is full
+ * @return
+ * SP_LOGGER_DEFINED 			- The logger has been defined
+ * SP_LOGGER_INVAlID_ARGUMENT	- If capacity is less than 1 or policy is invalid
+ * SP_LOGGER_OUT_OF_MEMORY 		- In case of memory allocation failure, or if the
+ * 								  writer thread cannot be started
+ * SP_LOGGER_CANNOT_OPEN_FILE 	- If the file given by filename cannot be opened
+ * SP_LOGGER_SUCCESS 			- In case the logger has been successfully opened
+ */
+SP_LOGGER_MSG spLoggerCreateAsync(const char* filename, SP_LOGGER_LEVEL level,
+		int capacity, SP_LOGGER_OVERFLOW_POLICY policy);
+
+/**
+ * Creates a rotating logger. Same as spLoggerCreateAsync, except that when
+ * the log file holds at least maxBytes bytes, or was opened at least
+ * maxSeconds seconds ago, the writer thread rotates it before writing the
+ * next record: <filename>.<i> is renamed to <filename>.<i+1> for every i
+ * below fileCount - 1 (<filename>.<fileCount-1> is overwritten), the log
+ * file is renamed to <filename>.1, and a new log file is started. Only the
+ * log file is kept if fileCount is 1. A file therefore exceeds maxBytes by
+ * at most one record, and the log takes at most about fileCount * maxBytes
+ * bytes.
+ *
+ * The next log file is created in advance as <filename>.next, with maxBytes
+ * bytes of disk space reserved by fallocate (where supported), and is
+ * removed by spLoggerDestroy.
+ *
+ * @param filename - The name of the log file, must not be NULL
+ * @param level - The level of the logger prints
+ * @param capacity - The number of records the buffer holds (rounded up to a
+ * 					 power of two)
+ * @param policy - What print functions do when the buffer is full
+ * @param maxBytes - The size at which the file is rotated, or 0 for no limit
+ * @param maxSeconds - The age at which the file is rotated, or 0 for no limit
+ * @param fileCount - The number of files kept, including the log file
+ * @return
+ * SP_LOGGER_DEFINED 			- The logger has been defined
+ * SP_LOGGER_INVAlID_ARGUMENT	- If filename is NULL, capacity is less than 1,
+ * 								  policy is invalid, a limit is negative, both
+ * 								  limits are 0 or fileCount is less than 1
+ * SP_LOGGER_OUT_OF_MEMORY 		- In case of memory allocation failure, or if the
+ * 								  writer thread cannot be started
+ * SP_LOGGER_CANNOT_OPEN_FILE 	- If the file given by filename cannot be opened
+ * SP_LOGGER_SUCCESS 			- In case the logger has been successfully opened
+ */
+SP_LOGGER_MSG spLoggerCreateRotating(const char* filename, SP_LOGGER_LEVEL level,
+		int capacity, SP_LOGGER_OVERFLOW_POLICY policy, long maxBytes, int maxSeconds,
+		int fileCount);
+
+/**
+ * Creates a binary logger. Same as spLoggerCreate, except that the log file
+ * holds binary records (in the byte order of the machine), which
+ * spLoggerDecode renders in the text format. Records printed through an
+ * SPLoggerSite (e.g. by the SP_LOG_* macros) hold only the id of the site,
+ * a timestamp and the message.
+ *
+ * @param filename - The name of the log file, if not specified stdout is used
+ * 					 as default.
+ * @param level - The level of the logger prints
+ * @return
+ * SP_LOGGER_DEFINED 			- The logger has been defined
+ * SP_LOGGER_OUT_OF_MEMORY 		- In case of memory allocation failure
+ * SP_LOGGER_CANNOT_OPEN_FILE 	- If the file given by filename cannot be opened
+ * SP_LOGGER_WRITE_FAIL			- If the header of the file cannot be written
+ * SP_LOGGER_SUCCESS 			- In case the logger has been successfully opened
+ */
+SP_LOGGER_MSG spLoggerCreateBinary(const char* filename, SP_LOGGER_LEVEL level);
+
+/**
+ * Creates a flight recorder: a logger which keeps its last capacity records
+ * in a file of fixed size, mapped into memory and used as a circular buffer.
+ * A print function copies its record into the next slot of the file, tagged
+ * with a sequence number, and does not write to the file; the kernel writes
+ * the mapped file, also after the process crashed. A record which was being
+ * copied during a crash is not read back. spLoggerDecode renders the records
+ * in the file, oldest first. A slot is claimed before the record is copied;
+ * if another thread is still copying a record into it, the new record is
+ * dropped and counted by spLoggerGetDroppedCount.
+ *
+ * The file is not truncated when the recorder opens it: an existing file,
+ * such as the one left by a process which crashed, is renamed to filename
+ * followed by ".prev", replacing an older ".prev" file, and a new file is
+ * created in its place.
+ *
+ * Each record takes 256 bytes. The file and the function names are cut to
+ * 63 characters, and the message to what is left of the slot. The
+ * capacity should be larger than the number of threads which print at once.
+ *
+ * @param filename - The name of the recorder file, must not be NULL
+ * @param level - The level of the logger prints
+ * @param capacity - The number of records kept
+ * @return
+ * SP_LOGGER_DEFINED 			- The logger has been defined
+ * SP_LOGGER_INVAlID_ARGUMENT	- If filename is NULL or capacity is less than 1
+ * SP_LOGGER_OUT_OF_MEMORY 		- In case of memory allocation failure, or if
+ * 								  the file cannot be mapped
+ * SP_LOGGER_CANNOT_OPEN_FILE 	- If the existing file cannot be renamed, or the
+ * 								  file given by filename cannot be created or sized
+ * SP_LOGGER_SUCCESS 			- In case the logger has been successfully opened
+ */
+SP_LOGGER_MSG spLoggerCreateFlightRecorder(const char* filename, SP_LOGGER_LEVEL level,
+		int capacity);
+
+/**
+ * Renders the log file written by a binary logger in the text format of the
+ * print functions. The output is identical to what a text logger of the
+ * same level would have written. The file of a flight recorder is rendered
+ * the same way, from its oldest record to its newest.
+ *
+ * @param binaryFilename - The name of the binary log file
+ * @param textFilename - The name of the text file to write, if not specified
+ * 						 stdout is used.
+ * @return
+ * SP_LOGGER_INVAlID_ARGUMENT	- If binaryFilename is NULL or the file is not a
+ * 								  valid binary log or flight recorder
+ * SP_LOGGER_CANNOT_OPEN_FILE 	- If either file cannot be opened
+ * SP_LOGGER_OUT_OF_MEMORY 		- In case of memory allocation failure
+ * SP_LOGGER_WRITE_FAIL			- If write failure occurred
+ * SP_LOGGER_SUCCESS			- otherwise
+ */
+SP_LOGGER_MSG spLoggerDecode(const char* binaryFilename, const char* textFilename);
+
+/**
+ * Returns the number of records an asynchronous logger has dropped because
+ * its buffer was full, or a flight recorder has dropped because their slot
+ * was still being written.
+ *
+ * @return
+ * 0 if the logger is undefined, or is neither asynchronous nor a flight recorder;
+ * The number of dropped records otherwise.
+ */
+unsigned long spLoggerGetDroppedCount();
+
 /**
  * Frees all memory allocated for the logger. If the logger is not defined
- * then nothing happens.
+ * then nothing happens. An asynchronous logger first writes all the records
+ * in its buffer.
  */
 void spLoggerDestroy();
 
@@ -102,6 +357,8 @@ void spLoggerDestroy();
  * SP_LOGGER_UNDIFINED 			- If the logger is undefined
  * SP_LOGGER_INVAlID_ARGUMENT	- If any of msg or file or function are null or line is negative
  * SP_LOGGER_WRITE_FAIL			- If Write failure occurred
+ * SP_LOGGER_BUFFER_FULL		- If the logger is asynchronous or a flight recorder and dropped the record
+ * SP_LOGGER_OUT_OF_MEMORY		- If the logger is asynchronous and a long record could not be copied
  * SP_LOGGER_SUCCESS			- otherwise
  */
 SP_LOGGER_MSG spLoggerPrintError(const char* msg, const char* file,
@@ -139,6 +396,8 @@ SP_LOGGER_MSG spLoggerPrintError(const char* msg, const char* file,
  * SP_LOGGER_UNDIFINED 			- If the logger is undefined
  * SP_LOGGER_INVAlID_ARGUMENT	- If any of msg or file or function are null or line is negative
  * SP_LOGGER_WRITE_FAIL			- If write failure occurred
+ * SP_LOGGER_BUFFER_FULL		- If the logger is asynchronous or a flight recorder and dropped the record
+ * SP_LOGGER_OUT_OF_MEMORY		- If the logger is asynchronous and a long record could not be copied
  * SP_LOGGER_SUCCESS			- otherwise
  */
 SP_LOGGER_MSG spLoggerPrintWarning(const char* msg, const char* file,
@@ -162,6 +421,8 @@ SP_LOGGER_MSG spLoggerPrintWarning(const char* msg, const char* file,
  * SP_LOGGER_UNDIFINED 			- If the logger is undefined
  * SP_LOGGER_INVAlID_ARGUMENT	- If msg is null
  * SP_LOGGER_WRITE_FAIL			- If Write failure occurred
+ * SP_LOGGER_BUFFER_FULL		- If the logger is asynchronous or a flight recorder and dropped the record
+ * SP_LOGGER_OUT_OF_MEMORY		- If the logger is asynchronous and a long record could not be copied
  * SP_LOGGER_SUCCESS			- otherwise
  */
 SP_LOGGER_MSG spLoggerPrintInfo(const char* msg);
@@ -196,6 +457,8 @@ SP_LOGGER_MSG spLoggerPrintInfo(const char* msg);
  * SP_LOGGER_UNDIFINED 			- If the logger is undefined
  * SP_LOGGER_INVAlID_ARGUMENT	- If any of msg or file or function are null or line is negative
  * SP_LOGGER_WRITE_FAIL			- If Write failure occurred
+ * SP_LOGGER_BUFFER_FULL		- If the logger is asynchronous or a flight recorder and dropped the record
+ * SP_LOGGER_OUT_OF_MEMORY		- If the logger is asynchronous and a long record could not be copied
  * SP_LOGGER_SUCCESS			- otherwise
  */
 SP_LOGGER_MSG spLoggerPrintDebug(const char* msg, const char* file,
@@ -210,8 +473,195 @@ SP_LOGGER_MSG spLoggerPrintDebug(const char* msg, const char* file,
  * SP_LOGGER_UNDIFINED 			- If the logger is undefined
  * SP_LOGGER_INVAlID_ARGUMENT	- If msg is null
  * SP_LOGGER_WRITE_FAIL			- If Write failure occurred
+ * SP_LOGGER_BUFFER_FULL		- If the logger is asynchronous or a flight recorder and dropped the record
+ * SP_LOGGER_OUT_OF_MEMORY		- If the logger is asynchronous and a long record could not be copied
  * SP_LOGGER_SUCCESS			- otherwise
  */
 SP_LOGGER_MSG spLoggerPrintMsg(const char* msg);
 
+/**
+ * Prints a message of the given call site, in the format of the print
+ * function of the site's type and at the same levels. A binary logger
+ * describes the site in the log the first time it prints it, and after that
+ * writes only the site's id with the message.
+ *
+ * @param site - The call site, which must stay valid while the program runs
+ * @param msg - The message to be printed
+ * @return
+ * SP_LOGGER_UNDIFINED 			- If the logger is undefined
+ * SP_LOGGER_INVAlID_ARGUMENT	- If site or msg are null, or the site is invalid
+ * SP_LOGGER_WRITE_FAIL			- If Write failure occurred
+ * SP_LOGGER_BUFFER_FULL		- If the logger is asynchronous or a flight recorder and dropped the record
+ * SP_LOGGER_OUT_OF_MEMORY		- In case of memory allocation failure
+ * SP_LOGGER_SUCCESS			- otherwise
+ */
+SP_LOGGER_MSG spLoggerPrintSite(SPLoggerSite* site, const char* msg);
+
+/**
+ * Same as spLoggerPrintSite, for a site some of whose records were not
+ * printed. The suppressed records are added to the count of the site, and
+ * if the count is positive and no count of the site was printed in the last
+ * second, the count is printed first as a record of the site, with the
+ * message "<count> log records of this call site were suppressed".
+ *
+ * @param site - The call site, which must stay valid while the program runs
+ * @param msg - The message to be printed
+ * @param suppressed - The number of records of the site that were suppressed
+ * 					   since the last one that was printed
+ * @return
+ * The same as spLoggerPrintSite
+ */
+SP_LOGGER_MSG spLoggerPrintSiteSuppressed(SPLoggerSite* site, const char* msg,
+		unsigned long suppressed);
+
+/**
+ * Takes a token from a token bucket, which gains perSecond tokens every
+ * second and holds at most burst tokens. A zeroed bucket is full.
+ *
+ * @param bucket - The bucket
+ * @param perSecond - The rate at which tokens are added
+ * @param burst - The capacity of the bucket
+ * @return
+ * true if the bucket had a token, false otherwise
+ */
+bool spLoggerTakeToken(SPLoggerBucket* bucket, double perSecond, double burst);
+
+/**
+ * The level of the logger as an int, or -1 if the logger is undefined.
+ * Used by the SP_LOG_* macros; do not change it.
+ */
+extern int spLoggerActiveLevel;
+
+/** Decides whether records of the given level are currently printed **/
+#define SP_LOGGER_IS_ENABLED(level) \
+	(__atomic_load_n(&spLoggerActiveLevel, __ATOMIC_RELAXED) >= (int) (level))
+
+/** Declares the static site of the given type at the current line **/
+#define SP_LOGGER_DECLARE_SITE(type) \
+	static SPLoggerSite spLoggerSite = { (type), __FILE__, __func__, __LINE__, 0, 0, 0, 0 }
+
+/** Prints msg through a static site of the given type at the current line **/
+#define SP_LOGGER_PRINT_AT_SITE(type, msg) do { \
+	SP_LOGGER_DECLARE_SITE(type); \
+	spLoggerPrintSite(&spLoggerSite, (msg)); \
+} while (0)
+
+/**
+ * Macros for printing a message with the file, function and line of the
+ * call. A macro does nothing, and does not evaluate msg, if the logger is
+ * undefined or its level does not print the record.
+ *
+ * @param msg - The message to be printed
+ */
+#define SP_LOG_ERROR(msg) do { \
+	if (SP_LOGGER_IS_ENABLED(SP_LOGGER_ERROR_LEVEL)) { \
+		SP_LOGGER_PRINT_AT_SITE(SP_LOGGER_ERROR_RECORD, msg); \
+	} \
+} while (0)
+
+#define SP_LOG_MSG(msg) do { \
+	if (SP_LOGGER_IS_ENABLED(SP_LOGGER_ERROR_LEVEL)) { \
+		SP_LOGGER_PRINT_AT_SITE(SP_LOGGER_MSG_RECORD, msg); \
+	} \
+} while (0)
+
+#if SP_LOGGER_COMPILE_LEVEL >= 1
+#define SP_LOG_WARNING(msg) do { \
+	if (SP_LOGGER_IS_ENABLED(SP_LOGGER_WARNING_ERROR_LEVEL)) { \
+		SP_LOGGER_PRINT_AT_SITE(SP_LOGGER_WARNING_RECORD, msg); \
+	} \
+} while (0)
+#else
+#define SP_LOG_WARNING(msg) do { } while (0)
+#endif
+
+#if SP_LOGGER_COMPILE_LEVEL >= 2
+#define SP_LOG_INFO(msg) do { \
+	if (SP_LOGGER_IS_ENABLED(SP_LOGGER_INFO_WARNING_ERROR_LEVEL)) { \
+		SP_LOGGER_PRINT_AT_SITE(SP_LOGGER_INFO_RECORD, msg); \
+	} \
+} while (0)
+#else
+#define SP_LOG_INFO(msg) do { } while (0)
+#endif
+
+#if SP_LOGGER_COMPILE_LEVEL >= 3
+#define SP_LOG_DEBUG(msg) do { \
+	if (SP_LOGGER_IS_ENABLED(SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL)) { \
+		SP_LOGGER_PRINT_AT_SITE(SP_LOGGER_DEBUG_RECORD, msg); \
+	} \
+} while (0)
+#else
+#define SP_LOG_DEBUG(msg) do { } while (0)
+#endif
+
+/**
+ * Decide whether records of each kind are compiled and currently printed;
+ * 0 for kinds removed by SP_LOGGER_COMPILE_LEVEL.
+ */
+#define SP_LOGGER_ENABLED_ERROR SP_LOGGER_IS_ENABLED(SP_LOGGER_ERROR_LEVEL)
+#define SP_LOGGER_ENABLED_MSG SP_LOGGER_IS_ENABLED(SP_LOGGER_ERROR_LEVEL)
+#if SP_LOGGER_COMPILE_LEVEL >= 1
+#define SP_LOGGER_ENABLED_WARNING SP_LOGGER_IS_ENABLED(SP_LOGGER_WARNING_ERROR_LEVEL)
+#else
+#define SP_LOGGER_ENABLED_WARNING 0
+#endif
+#if SP_LOGGER_COMPILE_LEVEL >= 2
+#define SP_LOGGER_ENABLED_INFO SP_LOGGER_IS_ENABLED(SP_LOGGER_INFO_WARNING_ERROR_LEVEL)
+#else
+#define SP_LOGGER_ENABLED_INFO 0
+#endif
+#if SP_LOGGER_COMPILE_LEVEL >= 3
+#define SP_LOGGER_ENABLED_DEBUG SP_LOGGER_IS_ENABLED(SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL)
+#else
+#define SP_LOGGER_ENABLED_DEBUG 0
+#endif
+
+/**
+ * Prints the first of every n records of the call site, counting the
+ * records of each thread separately. Records filtered by the level of the
+ * logger are not counted. For example SP_LOG_EVERY(WARNING, 1000, msg)
+ * prints one in 1000 warnings of the call.
+ *
+ * @param kind - One of ERROR, WARNING, INFO, DEBUG or MSG
+ * @param n - The sampling period, must be positive
+ * @param msg - The message to be printed
+ */
+#define SP_LOG_EVERY(kind, n, msg) do { \
+	if (SP_LOGGER_ENABLED_##kind) { \
+		SP_LOGGER_DECLARE_SITE(SP_LOGGER_##kind##_RECORD); \
+		static __thread unsigned long spLoggerSuppressed = 0; \
+		if (spLoggerSuppressed == 0 || spLoggerSuppressed >= (unsigned long) (n)) { \
+			spLoggerPrintSiteSuppressed(&spLoggerSite, (msg), \
+					spLoggerSuppressed == 0 ? 0 : spLoggerSuppressed - 1); \
+			spLoggerSuppressed = 0; \
+		} \
+		spLoggerSuppressed++; \
+	} \
+} while (0)
+
+/**
+ * Prints the records of the call site as long as the site's token bucket in
+ * the calling thread has tokens; see spLoggerTakeToken. Records filtered by
+ * the level of the logger take no token.
+ *
+ * @param kind - One of ERROR, WARNING, INFO, DEBUG or MSG
+ * @param perSecond - The number of records printed every second in the long run
+ * @param burst - The number of records printed in a burst
+ * @param msg - The message to be printed
+ */
+#define SP_LOG_LIMITED(kind, perSecond, burst, msg) do { \
+	if (SP_LOGGER_ENABLED_##kind) { \
+		SP_LOGGER_DECLARE_SITE(SP_LOGGER_##kind##_RECORD); \
+		static __thread SPLoggerBucket spLoggerBucket = { 0, 0 }; \
+		static __thread unsigned long spLoggerSuppressed = 0; \
+		if (spLoggerTakeToken(&spLoggerBucket, (perSecond), (burst))) { \
+			spLoggerPrintSiteSuppressed(&spLoggerSite, (msg), spLoggerSuppressed); \
+			spLoggerSuppressed = 0; \
+		} else { \
+			spLoggerSuppressed++; \
+		} \
+	} \
+} while (0)
+
 #endif
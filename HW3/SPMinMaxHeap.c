@@ -0,0 +1,231 @@
+#include "SPMinMaxHeap.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct sp_min_max_heap_t {
+	SPListElementValue* elements;
+	int size;
+	int capacity;
+};
+
+static bool lessThan(const SPListElementValue* e1,
+		const SPListElementValue* e2) {
+	return spListElementValueIsLess(*e1, *e2);
+}
+
+static void swap(SPMinMaxHeap heap, int i, int j) {
+	SPListElementValue temp = heap->elements[i];
+	heap->elements[i] = heap->elements[j];
+	heap->elements[j] = temp;
+}
+
+/*
+ * Nodes on even levels (the root is on level 0) are min nodes.
+ */
+static bool isMinLevel(int position) {
+	int level = 0;
+	for (position++; position > 1; position /= 2) {
+		level++;
+	}
+	return level % 2 == 0;
+}
+
+/*
+ * Decides whether the element at i should be closer to the root than
+ * the element at j, when both lie on the min levels (isMin) or on the max
+ * levels (!isMin).
+ */
+static bool precedes(SPMinMaxHeap heap, int i, int j, bool isMin) {
+	return isMin ? lessThan(&heap->elements[i], &heap->elements[j]) :
+			lessThan(&heap->elements[j], &heap->elements[i]);
+}
+
+static void pushUpLevel(SPMinMaxHeap heap, int position, bool isMin) {
+	int grandparent;
+	while (position > 2) {
+		grandparent = ((position - 1) / 2 - 1) / 2;
+		if (!precedes(heap, position, grandparent, isMin)) {
+			return;
+		}
+		swap(heap, position, grandparent);
+		position = grandparent;
+	}
+}
+
+static void pushUp(SPMinMaxHeap heap, int position) {
+	bool isMin;
+	int parent;
+	if (position == 0) {
+		return;
+	}
+	isMin = isMinLevel(position);
+	parent = (position - 1) / 2;
+	if (precedes(heap, parent, position, isMin)) {	// Belongs to the other levels
+		swap(heap, position, parent);
+		pushUpLevel(heap, parent, !isMin);
+	} else {
+		pushUpLevel(heap, position, isMin);
+	}
+}
+
+static void pushDown(SPMinMaxHeap heap, int position) {
+	bool isMin = isMinLevel(position);
+	int first, best, candidate, last, parent;
+	while ((first = 2 * position + 1) < heap->size) {
+		// Find the most extreme among the children and the grandchildren
+		best = first;
+		if (first + 1 < heap->size && precedes(heap, first + 1, best, isMin)) {
+			best = first + 1;
+		}
+		last = 4 * position + 6;
+		for (candidate = 4 * position + 3;
+				candidate <= last && candidate < heap->size; candidate++) {
+			if (precedes(heap, candidate, best, isMin)) {
+				best = candidate;
+			}
+		}
+		if (!precedes(heap, best, position, isMin)) {
+			return;
+		}
+		swap(heap, best, position);
+		if (best <= first + 1) {					// A child moved up, nothing else to fix
+			return;
+		}
+		parent = (best - 1) / 2;
+		if (precedes(heap, parent, best, isMin)) {	// Restore the order with the parent
+			swap(heap, best, parent);
+		}
+		position = best;
+	}
+}
+
+static int maxPosition(SPMinMaxHeap heap) {
+	if (heap->size <= 2) {
+		return heap->size - 1;
+	}
+	return lessThan(&heap->elements[1], &heap->elements[2]) ? 2 : 1;
+}
+
+SPMinMaxHeap spMinMaxHeapCreate(int capacity) {
+	SPMinMaxHeap heap;
+	if (capacity < 1) {
+		return NULL;
+	}
+	heap = (SPMinMaxHeap) malloc(sizeof(*heap));
+	if (heap == NULL) {
+		return NULL;
+	}
+	heap->elements = (SPListElementValue*) malloc(
+			sizeof(SPListElementValue) * capacity);
+	if (heap->elements == NULL) {
+		free(heap);
+		return NULL;
+	}
+	heap->size = 0;
+	heap->capacity = capacity;
+	return heap;
+}
+
+SPMinMaxHeap spMinMaxHeapCopy(SPMinMaxHeap heap) {
+	SPMinMaxHeap copy;
+	if (heap == NULL) {
+		return NULL;
+	}
+	copy = spMinMaxHeapCreate(heap->capacity);
+	if (copy == NULL) {
+		return NULL;
+	}
+	memcpy(copy->elements, heap->elements,
+			sizeof(SPListElementValue) * heap->size);
+	copy->size = heap->size;
+	return copy;
+}
+
+void spMinMaxHeapDestroy(SPMinMaxHeap heap) {
+	if (heap == NULL) {
+		return;
+	}
+	free(heap->elements);
+	free(heap);
+}
+
+void spMinMaxHeapClear(SPMinMaxHeap heap) {
+	if (heap == NULL) {
+		return;
+	}
+	heap->size = 0;
+}
+
+int spMinMaxHeapGetSize(SPMinMaxHeap heap) {
+	return heap == NULL ? -1 : heap->size;
+}
+
+int spMinMaxHeapGetCapacity(SPMinMaxHeap heap) {
+	return heap == NULL ? -1 : heap->capacity;
+}
+
+SP_MINMAX_HEAP_MSG spMinMaxHeapInsert(SPMinMaxHeap heap, SPListElement element) {
+	if (heap == NULL || element == NULL) {
+		return SP_MINMAX_HEAP_NULL_ARGUMENT;
+	}
+	if (heap->size == heap->capacity) {
+		return SP_MINMAX_HEAP_FULL;
+	}
+	heap->elements[heap->size] = *element;
+	heap->size++;
+	pushUp(heap, heap->size - 1);
+	return SP_MINMAX_HEAP_SUCCESS;
+}
+
+SPListElement spMinMaxHeapGetMin(SPMinMaxHeap heap) {
+	if (heap == NULL || heap->size == 0) {
+		return NULL;
+	}
+	return &heap->elements[0];
+}
+
+SPListElement spMinMaxHeapGetMax(SPMinMaxHeap heap) {
+	if (heap == NULL || heap->size == 0) {
+		return NULL;
+	}
+	return &heap->elements[maxPosition(heap)];
+}
+
+SP_MINMAX_HEAP_MSG spMinMaxHeapRemoveMin(SPMinMaxHeap heap) {
+	if (heap == NULL) {
+		return SP_MINMAX_HEAP_NULL_ARGUMENT;
+	}
+	if (heap->size == 0) {
+		return SP_MINMAX_HEAP_EMPTY;
+	}
+	heap->size--;
+	if (heap->size > 0) {
+		heap->elements[0] = heap->elements[heap->size];
+		pushDown(heap, 0);
+	}
+	return SP_MINMAX_HEAP_SUCCESS;
+}
+
+SP_MINMAX_HEAP_MSG spMinMaxHeapRemoveMax(SPMinMaxHeap heap) {
+	int position;
+	if (heap == NULL) {
+		return SP_MINMAX_HEAP_NULL_ARGUMENT;
+	}
+	if (heap->size == 0) {
+		return SP_MINMAX_HEAP_EMPTY;
+	}
+	position = maxPosition(heap);
+	heap->size--;
+	if (position < heap->size) {
+		heap->elements[position] = heap->elements[heap->size];
+		pushDown(heap, position);
+	}
+	return SP_MINMAX_HEAP_SUCCESS;
+}
+
+SPListElement spMinMaxHeapGetAt(SPMinMaxHeap heap, int position) {
+	if (heap == NULL || position < 0 || position >= heap->size) {
+		return NULL;
+	}
+	return &heap->elements[position];
+}
@@ -0,0 +1,168 @@
+#ifndef SPMINMAXHEAP_H_
+#define SPMINMAXHEAP_H_
+#include "SPListElement.h"
+#include <stdbool.h>
+/**
+ * Min-Max Heap Summary
+ *
+ * A fixed-capacity double-ended priority queue of list elements, ordered
+ * by spListElementCompare. Elements are stored by value in one contiguous
+ * array, laid out as a min-max heap: nodes on even levels are not greater
+ * than their descendants and nodes on odd levels are not less than them.
+ * Both the minimal and the maximal element are found in O(1), and
+ * insertion and removal from either end take O(log n).
+ *
+ * Elements returned by the heap are owned by it. They must not be destroyed
+ * and they are valid only until the heap is changed.
+ *
+ * The following functions are available:
+ *
+ *   spMinMaxHeapCreate			- Creates a new empty heap.
+ *   spMinMaxHeapCopy			- Copies an existing heap.
+ *   spMinMaxHeapDestroy		- Frees all memory allocations associated with a heap.
+ *   spMinMaxHeapClear			- Clears all elements from a heap.
+ *   spMinMaxHeapGetSize		- Returns the current number of elements.
+ *   spMinMaxHeapGetCapacity	- Returns the maximal number of elements.
+ *   spMinMaxHeapInsert			- Inserts a copy of an element.
+ *   spMinMaxHeapGetMin			- Returns the minimal element.
+ *   spMinMaxHeapGetMax			- Returns the maximal element.
+ *   spMinMaxHeapRemoveMin		- Removes the minimal element.
+ *   spMinMaxHeapRemoveMax		- Removes the maximal element.
+ *   spMinMaxHeapGetAt			- Returns the element stored at a given position.
+ */
+
+/** Type for defining the heap **/
+typedef struct sp_min_max_heap_t* SPMinMaxHeap;
+
+/** Type used for returning error codes from heap functions **/
+typedef enum sp_min_max_heap_msg_t {
+	SP_MINMAX_HEAP_SUCCESS,
+	SP_MINMAX_HEAP_NULL_ARGUMENT,
+	SP_MINMAX_HEAP_FULL,
+	SP_MINMAX_HEAP_EMPTY
+} SP_MINMAX_HEAP_MSG;
+
+/**
+ * Creates a new empty heap which can hold up to capacity elements.
+ *
+ * @param capacity - The maximal number of elements in the heap.
+ * @return
+ * NULL in case of a memory allocation failure or if capacity is less than 1;
+ * The new heap otherwise.
+ */
+SPMinMaxHeap spMinMaxHeapCreate(int capacity);
+
+/**
+ * Creates a copy of a given heap.
+ *
+ * @param heap - The heap to be copied.
+ * @return
+ * NULL if a NULL was sent or in case of a memory allocation failure;
+ * The new copy otherwise.
+ */
+SPMinMaxHeap spMinMaxHeapCopy(SPMinMaxHeap heap);
+
+/**
+ * Frees all memory allocations associated with a heap.
+ * Does nothing if given a NULL argument.
+ *
+ * @param heap - The heap to be destroyed.
+ */
+void spMinMaxHeapDestroy(SPMinMaxHeap heap);
+
+/**
+ * Removes all elements from a heap.
+ * Does nothing if given a NULL argument.
+ *
+ * @param heap - The heap to be cleared.
+ */
+void spMinMaxHeapClear(SPMinMaxHeap heap);
+
+/**
+ * Returns the number of elements in a heap.
+ *
+ * @param heap - The query heap.
+ * @return
+ * -1 if a NULL was sent;
+ * The number of elements otherwise.
+ */
+int spMinMaxHeapGetSize(SPMinMaxHeap heap);
+
+/**
+ * Returns the capacity of a heap.
+ *
+ * @param heap - The query heap.
+ * @return
+ * -1 if a NULL was sent;
+ * The maximal number of elements otherwise.
+ */
+int spMinMaxHeapGetCapacity(SPMinMaxHeap heap);
+
+/**
+ * Inserts a copy of an element into a heap.
+ *
+ * @param heap - The target heap.
+ * @param element - The element to insert. The element is copied by value.
+ * @return
+ * SP_MINMAX_HEAP_NULL_ARGUMENT if a NULL was sent as heap or element;
+ * SP_MINMAX_HEAP_FULL if the heap holds capacity elements;
+ * SP_MINMAX_HEAP_SUCCESS otherwise.
+ */
+SP_MINMAX_HEAP_MSG spMinMaxHeapInsert(SPMinMaxHeap heap, SPListElement element);
+
+/**
+ * Returns the minimal element of a heap.
+ *
+ * @param heap - The query heap.
+ * @return
+ * NULL if a NULL was sent or the heap is empty;
+ * The minimal element otherwise.
+ */
+SPListElement spMinMaxHeapGetMin(SPMinMaxHeap heap);
+
+/**
+ * Returns the maximal element of a heap.
+ *
+ * @param heap - The query heap.
+ * @return
+ * NULL if a NULL was sent or the heap is empty;
+ * The maximal element otherwise.
+ */
+SPListElement spMinMaxHeapGetMax(SPMinMaxHeap heap);
+
+/**
+ * Removes the minimal element of a heap.
+ *
+ * @param heap - The target heap.
+ * @return
+ * SP_MINMAX_HEAP_NULL_ARGUMENT if a NULL was sent;
+ * SP_MINMAX_HEAP_EMPTY if the heap is empty;
+ * SP_MINMAX_HEAP_SUCCESS otherwise.
+ */
+SP_MINMAX_HEAP_MSG spMinMaxHeapRemoveMin(SPMinMaxHeap heap);
+
+/**
+ * Removes the maximal element of a heap.
+ *
+ * @param heap - The target heap.
+ * @return
+ * SP_MINMAX_HEAP_NULL_ARGUMENT if a NULL was sent;
+ * SP_MINMAX_HEAP_EMPTY if the heap is empty;
+ * SP_MINMAX_HEAP_SUCCESS otherwise.
+ */
+SP_MINMAX_HEAP_MSG spMinMaxHeapRemoveMax(SPMinMaxHeap heap);
+
+/**
+ * Returns the element stored at the given position of the heap's array.
+ * Positions 0 to size-1 hold all elements of the heap in heap order, not
+ * in sorted order. Useful for visiting all elements without removing them.
+ *
+ * @param heap - The query heap.
+ * @param position - The position in the heap's array.
+ * @return
+ * NULL if a NULL was sent or position is not in [0, size);
+ * The element at the given position otherwise.
+ */
+SPListElement spMinMaxHeapGetAt(SPMinMaxHeap heap, int position);
+
+#endif /* SPMINMAXHEAP_H_ */
@@ -0,0 +1,122 @@
+#ifndef SPPACKEDELEMENT_H_
+#define SPPACKEDELEMENT_H_
+#include "SPListElement.h"
+#include <stdint.h>
+#include <string.h>
+/**
+ * Packed List Element Summary
+ *
+ * A packed element holds an element with a float precision value in a
+ * single 64 bit word: the upper 32 bits hold the bits of the value (with the
+ * sign bit flipped, and all other bits also flipped for negative values)
+ * and the lower 32 bits hold the index. With this encoding an unsigned
+ * integer comparison of two packed elements orders them as
+ * spListElementCompare does: by value first, then by index. Sorting,
+ * selecting and comparing packed elements are therefore plain integer
+ * operations, and a packed element takes half the memory of an
+ * SPListElementValue.
+ *
+ * The value is rounded to float precision when packed, so two elements whose
+ * values differ only beyond float precision compare by their index. -0.0 is
+ * packed as 0.0. NaN values are not supported.
+ *
+ * The following inline functions are available:
+ *
+ *   spPackedElementCreate		- Packs an index and a value
+ *   spPackedElementFromValue	- Packs an element value
+ *   spPackedElementToValue		- Unpacks a packed element into an element value
+ *   spPackedElementGetIndex	- Returns the index of a packed element
+ *   spPackedElementGetValue	- Returns the value of a packed element
+ *   spPackedElementCompare		- Compares two packed elements
+ */
+
+/** Type used to hold a packed element **/
+typedef uint64_t SPPackedElement;
+
+/** A packed element which is greater than every packed element of an actual element **/
+#define SP_PACKED_ELEMENT_MAX UINT64_MAX
+
+/**
+ * Packs an index and a value into a packed element. The value is rounded to
+ * float precision.
+ *
+ * @param index The index of the element, must be greater or equal to 0
+ * @param value The value of the element
+ * @return
+ * The packed element
+ */
+static inline SPPackedElement spPackedElementCreate(int index, double value) {
+	float rounded = (float) value;
+	uint32_t bits;
+	if (rounded == 0.0f) {				// Pack -0.0 as 0.0
+		rounded = 0.0f;
+	}
+	memcpy(&bits, &rounded, sizeof(bits));
+	bits = (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+	return ((SPPackedElement) bits << 32) | (uint32_t) index;
+}
+
+/**
+ * Packs an element value. The value is rounded to float precision.
+ *
+ * @param data The element value
+ * @return
+ * The packed element
+ */
+static inline SPPackedElement spPackedElementFromValue(SPListElementValue data) {
+	return spPackedElementCreate(data.index, data.value);
+}
+
+/**
+ * Returns the index of a packed element.
+ *
+ * @param element The packed element
+ * @return
+ * The index of the element
+ */
+static inline int spPackedElementGetIndex(SPPackedElement element) {
+	return (int) (uint32_t) element;
+}
+
+/**
+ * Returns the value of a packed element.
+ *
+ * @param element The packed element
+ * @return
+ * The value of the element, in float precision
+ */
+static inline double spPackedElementGetValue(SPPackedElement element) {
+	uint32_t bits = (uint32_t) (element >> 32);
+	float value;
+	bits = (bits & 0x80000000u) ? bits & 0x7FFFFFFFu : ~bits;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+/**
+ * Unpacks a packed element into an element value.
+ *
+ * @param element The packed element
+ * @return
+ * The element value with the index and value of the packed element
+ */
+static inline SPListElementValue spPackedElementToValue(SPPackedElement element) {
+	return spListElementValueCreate(spPackedElementGetIndex(element),
+			spPackedElementGetValue(element));
+}
+
+/**
+ * Compares two packed elements, by the same relation as spListElementCompare.
+ *
+ * @param e1 The first packed element to be compared
+ * @param e2 The second packed element to be compared with
+ * @return
+ * -1 if e1 is less than e2
+ * 0  if e1 and e2 are equal
+ * 1  if e1 is bigger than e2
+ */
+static inline int spPackedElementCompare(SPPackedElement e1, SPPackedElement e2) {
+	return (e1 > e2) - (e1 < e2);
+}
+
+#endif /* SPPACKEDELEMENT_H_ */
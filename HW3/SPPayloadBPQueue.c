@@ -0,0 +1,206 @@
+#include "SPPayloadBPQueue.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/*
+ * Slots are kept sorted in decreasing order, so the maximal element (the
+ * one evicted by an insertion into a full queue) is slots[0] and the
+ * minimal element is slots[size-1], which Dequeue removes without moving
+ * any other slot.
+ */
+struct sp_payload_bp_queue_t {
+	int maxSize;
+	int size;
+	size_t payloadSize;
+	size_t slotSize;		// An SPListElementValue and the payload, padded to
+							// keep slots aligned
+	unsigned char* slots;
+};
+
+static SPListElementValue* slotAt(SPPayloadBPQueue source, int position) {
+	return (SPListElementValue*) (source->slots + source->slotSize * position);
+}
+
+static bool lessThan(int index1, double value1, const SPListElementValue* slot) {
+	return spListElementValueIsLess(spListElementValueCreate(index1, value1), *slot);
+}
+
+/*
+ * Returns the number of elements which are greater than (index, value),
+ * which is the position of the element in the decreasing slot order.
+ */
+static int findPosition(SPPayloadBPQueue source, int index, double value) {
+	int low = 0, high = source->size, middle;
+	while (low < high) {
+		middle = low + (high - low) / 2;
+		if (lessThan(index, value, slotAt(source, middle))) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+SPPayloadBPQueue spPayloadBPQueueCreate(int maxSize, size_t payloadSize) {
+	SPPayloadBPQueue queue;
+	size_t alignment = sizeof(SPListElementValue);
+	if (maxSize < 1) {								// Invalid Size Bound
+		return NULL;
+	}
+	queue = (SPPayloadBPQueue) malloc(sizeof(struct sp_payload_bp_queue_t));
+	if (!queue) {									// Allocation failure
+		return NULL;
+	}
+	queue->maxSize = maxSize;
+	queue->size = 0;
+	queue->payloadSize = payloadSize;
+	queue->slotSize = sizeof(SPListElementValue) +
+			(payloadSize + alignment - 1) / alignment * alignment;
+	queue->slots = (unsigned char*) malloc(queue->slotSize * maxSize);
+	if (!queue->slots) {							// Allocation failure
+		free(queue);
+		return NULL;
+	}
+	return queue;
+}
+
+SPPayloadBPQueue spPayloadBPQueueCopy(SPPayloadBPQueue source) {
+	SPPayloadBPQueue copy;
+	if (!source) {									// Invalid input
+		return NULL;
+	}
+	copy = spPayloadBPQueueCreate(source->maxSize, source->payloadSize);
+	if (!copy) {									// Allocation failure
+		return NULL;
+	}
+	memcpy(copy->slots, source->slots, source->slotSize * source->size);
+	copy->size = source->size;
+	return copy;
+}
+
+void spPayloadBPQueueDestroy(SPPayloadBPQueue source) {
+	if (!source) {									// NULL input
+		return;
+	}
+	free(source->slots);
+	free(source);
+}
+
+void spPayloadBPQueueClear(SPPayloadBPQueue source) {
+	if (!source) {									// NULL input
+		return;
+	}
+	source->size = 0;
+}
+
+int spPayloadBPQueueSize(SPPayloadBPQueue source) {
+	return source ? source->size : -1;
+}
+
+int spPayloadBPQueueGetMaxSize(SPPayloadBPQueue source) {
+	return source ? source->maxSize : -1;
+}
+
+size_t spPayloadBPQueueGetPayloadSize(SPPayloadBPQueue source) {
+	return source ? source->payloadSize : 0;
+}
+
+SP_BPQUEUE_MSG spPayloadBPQueueEnqueue(SPPayloadBPQueue source, int index,
+		double value, const void* payload) {
+	SPListElementValue* slot;
+	int position;
+	if (!source || index < 0 || value < 0.0 ||
+			(!payload && source->payloadSize > 0)) {	// Invalid input
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	if (source->size == source->maxSize) {
+		if (!lessThan(index, value, slotAt(source, 0))) {
+			return SP_BPQUEUE_FULL;
+		}
+		// Evict the maximal element by shifting the greater ones over it
+		position = findPosition(source, index, value) - 1;
+		memmove(source->slots, slotAt(source, 1), source->slotSize * position);
+	} else {
+		// Make room by shifting the smaller elements one slot down
+		position = findPosition(source, index, value);
+		memmove(slotAt(source, position + 1), slotAt(source, position),
+				source->slotSize * (source->size - position));
+		source->size++;
+	}
+	slot = slotAt(source, position);
+	slot->index = index;
+	slot->value = value;
+	if (source->payloadSize > 0) {
+		memcpy(slot + 1, payload, source->payloadSize);
+	}
+	return SP_BPQUEUE_SUCCESS;
+}
+
+SP_BPQUEUE_MSG spPayloadBPQueueDequeue(SPPayloadBPQueue source) {
+	if (!source) {									// Invalid input
+		return SP_BPQUEUE_INVALID_ARGUMENT;
+	}
+	if (source->size == 0) {
+		return SP_BPQUEUE_EMPTY;
+	}
+	source->size--;
+	return SP_BPQUEUE_SUCCESS;
+}
+
+bool spPayloadBPQueueGetAt(SPPayloadBPQueue source, int rank, int* index,
+		double* value, const void** payload) {
+	SPListElementValue* slot;
+	if (!source || rank < 0 || rank >= source->size) {	// Invalid input
+		return false;
+	}
+	slot = slotAt(source, source->size - 1 - rank);
+	if (index) {
+		*index = slot->index;
+	}
+	if (value) {
+		*value = slot->value;
+	}
+	if (payload) {
+		*payload = slot + 1;
+	}
+	return true;
+}
+
+bool spPayloadBPQueuePeek(SPPayloadBPQueue source, int* index, double* value,
+		const void** payload) {
+	return spPayloadBPQueueGetAt(source, 0, index, value, payload);
+}
+
+bool spPayloadBPQueuePeekLast(SPPayloadBPQueue source, int* index, double* value,
+		const void** payload) {
+	if (!source) {									// Invalid input
+		return false;
+	}
+	return spPayloadBPQueueGetAt(source, source->size - 1, index, value, payload);
+}
+
+double spPayloadBPQueueMinValue(SPPayloadBPQueue source) {
+	if (!source || source->size == 0) {
+		return -1;
+	}
+	return slotAt(source, source->size - 1)->value;
+}
+
+double spPayloadBPQueueMaxValue(SPPayloadBPQueue source) {
+	if (!source || source->size == 0) {
+		return -1;
+	}
+	return slotAt(source, 0)->value;
+}
+
+bool spPayloadBPQueueIsEmpty(SPPayloadBPQueue source) {
+	assert(source != NULL);
+	return source->size == 0;
+}
+
+bool spPayloadBPQueueIsFull(SPPayloadBPQueue source) {
+	assert(source != NULL);
+	return source->size == source->maxSize;
+}
@@ -0,0 +1,225 @@
+#ifndef SPPAYLOADBPQUEUE_H_
+#define SPPAYLOADBPQUEUE_H_
+#include "SPBPriorityQueue.h"
+#include <stdbool.h>
+#include <stddef.h>
+/**
+ * Payload Bounded Priority-Queue Summary
+ *
+ * A bounded priority queue whose elements carry, in addition to an index
+ * and a value, an opaque payload of a fixed size which is set at creation.
+ * Elements are ordered as in spListElementCompare and the queue keeps the
+ * minimal ones, following the semantics of SPBPQueue.
+ *
+ * Each element is stored together with its payload in one slot of a single
+ * contiguous array, and elements are moved between slots with memcpy. After
+ * creation the queue never allocates memory, and a result's payload is read
+ * directly from its slot without any side table lookup.
+ *
+ * Payload pointers returned by the queue point into the queue's own slots.
+ * They must not be freed and they are valid only until the queue is changed.
+ *
+ * The following functions are available:
+ *
+ *   spPayloadBPQueueCreate			- Creates a new empty payload BPQ.
+ *   spPayloadBPQueueCopy			- Copies an existing payload BPQ.
+ *   spPayloadBPQueueDestroy		- Frees all memory allocations associated with a payload BPQ.
+ *   spPayloadBPQueueClear			- Clears all elements from a payload BPQ.
+ *   spPayloadBPQueueSize			- Returns the current number of elements.
+ *   spPayloadBPQueueGetMaxSize		- Returns a payload BPQ's size bound.
+ *   spPayloadBPQueueGetPayloadSize	- Returns the size of each element's payload.
+ *   spPayloadBPQueueEnqueue		- Inserts an (index, value, payload) element.
+ *   spPayloadBPQueueDequeue		- Removes the minimal element.
+ *   spPayloadBPQueuePeek			- Returns the minimal element.
+ *   spPayloadBPQueuePeekLast		- Returns the maximal element.
+ *   spPayloadBPQueueGetAt			- Returns the element of a given rank.
+ *   spPayloadBPQueueMinValue		- Returns the minimal value.
+ *   spPayloadBPQueueMaxValue		- Returns the maximal value.
+ *   spPayloadBPQueueIsEmpty		- Decides whether a payload BPQ is empty.
+ *   spPayloadBPQueueIsFull			- Decides whether a payload BPQ is full.
+ */
+
+/** type used to define a bounded priority queue with payloads **/
+typedef struct sp_payload_bp_queue_t* SPPayloadBPQueue;
+
+/**
+ * Creates a new payload BPQ with the given size bound. All memory used by
+ * the queue is allocated here.
+ *
+ * @param maxSize - The size bound of the queue.
+ * @param payloadSize - The size in bytes of each element's payload (may be 0).
+ * @return
+ * NULL in case of a memory allocation failure or if the input bound is less than 1;
+ * The new payload BPQ otherwise.
+ */
+SPPayloadBPQueue spPayloadBPQueueCreate(int maxSize, size_t payloadSize);
+
+/**
+ * Creates a copy of a given payload BPQ, including all payloads.
+ *
+ * @param source - The queue to be copied.
+ * @return
+ * NULL if a NULL was sent or in case of a memory allocation failure;
+ * The new copy otherwise.
+ */
+SPPayloadBPQueue spPayloadBPQueueCopy(SPPayloadBPQueue source);
+
+/**
+ * Frees all memory allocations associated with a payload BPQ.
+ * Does nothing if given a NULL argument.
+ *
+ * @param source - The queue to be destroyed.
+ */
+void spPayloadBPQueueDestroy(SPPayloadBPQueue source);
+
+/**
+ * Clears a payload BPQ of all its elements.
+ * Does nothing if given a NULL argument.
+ *
+ * @param source - The queue to be cleared.
+ */
+void spPayloadBPQueueClear(SPPayloadBPQueue source);
+
+/**
+ * Returns the number of elements of a given payload BPQ.
+ *
+ * @param source - The query queue.
+ * @return
+ * -1 if given a NULL argument;
+ * The queue size otherwise.
+ */
+int spPayloadBPQueueSize(SPPayloadBPQueue source);
+
+/**
+ * Returns the size bound of a given payload BPQ.
+ *
+ * @param source - The query queue.
+ * @return
+ * -1 if given a NULL argument;
+ * The queue size bound otherwise.
+ */
+int spPayloadBPQueueGetMaxSize(SPPayloadBPQueue source);
+
+/**
+ * Returns the size in bytes of the payload of each element of the queue.
+ *
+ * @param source - The query queue.
+ * @return
+ * 0 if given a NULL argument;
+ * The payload size otherwise.
+ */
+size_t spPayloadBPQueueGetPayloadSize(SPPayloadBPQueue source);
+
+/**
+ * Inserts a new element with the given index, value and payload to the
+ * queue. The payload is copied into the queue. If the queue is full, the
+ * element is inserted only if it is less than the maximal element of the
+ * queue, which is then removed.
+ *
+ * @param source - The input queue.
+ * @param index - The index of the new element (index >= 0).
+ * @param value - The value of the new element (value >= 0.0).
+ * @param payload - The payload to copy. May be NULL only if the payload size is 0.
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if source is NULL, payload is missing or
+ *  index/value are negative;
+ * SP_BPQUEUE_FULL if the queue is full AND the new element is not
+ *  less than the current maximal element of the queue;
+ * SP_BPQUEUE_SUCCESS otherwise (i.e. the insertion succeeded).
+ */
+SP_BPQUEUE_MSG spPayloadBPQueueEnqueue(SPPayloadBPQueue source, int index,
+		double value, const void* payload);
+
+/**
+ * Removes the minimal element of the queue, together with its payload.
+ *
+ * @param source - The input queue.
+ * @return
+ * SP_BPQUEUE_INVALID_ARGUMENT if given a NULL argument;
+ * SP_BPQUEUE_EMPTY if the queue is empty;
+ * SP_BPQUEUE_SUCCESS otherwise.
+ */
+SP_BPQUEUE_MSG spPayloadBPQueueDequeue(SPPayloadBPQueue source);
+
+/**
+ * Returns the element of the given rank in the queue, where rank 0 is the
+ * minimal element. Each output argument may be NULL if it is not needed.
+ * The payload is returned by pointer into the queue, without copying.
+ *
+ * @param source - The query queue.
+ * @param rank - The rank of the requested element (0 <= rank < size).
+ * @param index - Set to the index of the element.
+ * @param value - Set to the value of the element.
+ * @param payload - Set to the address of the element's payload.
+ * @return
+ * false if source is NULL or rank is out of range;
+ * true otherwise.
+ */
+bool spPayloadBPQueueGetAt(SPPayloadBPQueue source, int rank, int* index,
+		double* value, const void** payload);
+
+/**
+ * Returns the minimal element of the queue. Same as spPayloadBPQueueGetAt
+ * with rank 0.
+ *
+ * @return
+ * false if source is NULL or the queue is empty;
+ * true otherwise.
+ */
+bool spPayloadBPQueuePeek(SPPayloadBPQueue source, int* index, double* value,
+		const void** payload);
+
+/**
+ * Returns the maximal element of the queue. Same as spPayloadBPQueueGetAt
+ * with rank size-1.
+ *
+ * @return
+ * false if source is NULL or the queue is empty;
+ * true otherwise.
+ */
+bool spPayloadBPQueuePeekLast(SPPayloadBPQueue source, int* index, double* value,
+		const void** payload);
+
+/**
+ * Returns the minimal value in the queue.
+ *
+ * @param source - The query queue.
+ * @return
+ * -1 if given a NULL argument or the queue is empty;
+ * The minimal value otherwise.
+ */
+double spPayloadBPQueueMinValue(SPPayloadBPQueue source);
+
+/**
+ * Returns the maximal value in the queue.
+ *
+ * @param source - The query queue.
+ * @return
+ * -1 if given a NULL argument or the queue is empty;
+ * The maximal value otherwise.
+ */
+double spPayloadBPQueueMaxValue(SPPayloadBPQueue source);
+
+/**
+ * Decides whether a given payload BPQ is empty.
+ *
+ * @param source - The query queue.
+ * @assert source != NULL
+ * @return
+ * True if the input queue is empty;
+ * False otherwise.
+ */
+bool spPayloadBPQueueIsEmpty(SPPayloadBPQueue source);
+
+/**
+ * Decides whether a given payload BPQ is full.
+ *
+ * @param source - The query queue.
+ * @assert source != NULL
+ * @return
+ * True if the input queue is full;
+ * False otherwise.
+ */
+bool spPayloadBPQueueIsFull(SPPayloadBPQueue source);
+
+#endif /* SPPAYLOADBPQUEUE_H_ */
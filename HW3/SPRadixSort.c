@@ -0,0 +1,262 @@
+#include "SPRadixSort.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#define BUCKETS 256
+#define DIGIT_BITS 8
+#define INDEX_PASSES 4					// Digits of the index key, sorted first
+#define PASSES 12						// And then the 8 digits of the value key
+#define SIGN_BIT_64 0x8000000000000000ull
+#define SIGN_BIT_32 0x80000000u
+
+/** Keys of the elements, one array per field **/
+typedef struct radix_keys_t {
+	uint32_t* indexes;
+	uint64_t* values;
+} Keys;
+
+typedef enum radix_phase_t {
+	FILL_PHASE,							// Map the elements to keys and count digits
+	COUNT_PHASE,						// Count the digits of one pass
+	SCATTER_PHASE,						// Move the keys by the digits of one pass
+	DRAIN_PHASE							// Map the keys back to elements
+} RadixPhase;
+
+/** The work of one thread on a contiguous block of elements **/
+typedef struct radix_task_t {
+	RadixPhase phase;
+	int begin;
+	int end;
+	int pass;
+	Keys* source;
+	Keys* target;
+	int* indexes;
+	double* values;
+	int counts[PASSES][BUCKETS];		// Digit counts of the block, or offsets
+} RadixTask;
+
+static uint64_t valueToKey(double value) {
+	uint64_t bits;
+	if (value == 0.0) {					// Sort -0.0 as 0.0
+		value = 0.0;
+	}
+	memcpy(&bits, &value, sizeof(bits));
+	return (bits & SIGN_BIT_64) ? ~bits : bits | SIGN_BIT_64;
+}
+
+static double keyToValue(uint64_t key) {
+	double value;
+	key = (key & SIGN_BIT_64) ? key & ~SIGN_BIT_64 : ~key;
+	memcpy(&value, &key, sizeof(value));
+	return value;
+}
+
+static void fillKeys(RadixTask* task) {
+	memset(task->counts, 0, sizeof(task->counts));
+	for (int i = task->begin; i < task->end; i++) {
+		uint32_t index = (uint32_t) task->indexes[i] ^ SIGN_BIT_32;
+		uint64_t value = valueToKey(task->values[i]);
+		task->source->indexes[i] = index;
+		task->source->values[i] = value;
+		for (int pass = 0; pass < INDEX_PASSES; pass++) {
+			task->counts[pass][(index >> (pass * DIGIT_BITS)) & (BUCKETS - 1)]++;
+		}
+		for (int pass = INDEX_PASSES; pass < PASSES; pass++) {
+			task->counts[pass][(value >> ((pass - INDEX_PASSES) * DIGIT_BITS)) &
+					(BUCKETS - 1)]++;
+		}
+	}
+}
+
+static void countDigits(RadixTask* task) {
+	int* counts = task->counts[task->pass];
+	memset(counts, 0, sizeof(task->counts[0]));
+	if (task->pass < INDEX_PASSES) {
+		int shift = task->pass * DIGIT_BITS;
+		for (int i = task->begin; i < task->end; i++) {
+			counts[(task->source->indexes[i] >> shift) & (BUCKETS - 1)]++;
+		}
+	} else {
+		int shift = (task->pass - INDEX_PASSES) * DIGIT_BITS;
+		for (int i = task->begin; i < task->end; i++) {
+			counts[(task->source->values[i] >> shift) & (BUCKETS - 1)]++;
+		}
+	}
+}
+
+/*
+ * Moves the keys of the block to their positions in the target arrays. The
+ * counts of the pass hold the first position of every digit.
+ */
+static void scatterKeys(RadixTask* task) {
+	int* offsets = task->counts[task->pass];
+	Keys* source = task->source;
+	Keys* target = task->target;
+	if (task->pass < INDEX_PASSES) {
+		int shift = task->pass * DIGIT_BITS;
+		for (int i = task->begin; i < task->end; i++) {
+			int position = offsets[(source->indexes[i] >> shift) & (BUCKETS - 1)]++;
+			target->indexes[position] = source->indexes[i];
+			target->values[position] = source->values[i];
+		}
+	} else {
+		int shift = (task->pass - INDEX_PASSES) * DIGIT_BITS;
+		for (int i = task->begin; i < task->end; i++) {
+			int position = offsets[(source->values[i] >> shift) & (BUCKETS - 1)]++;
+			target->indexes[position] = source->indexes[i];
+			target->values[position] = source->values[i];
+		}
+	}
+}
+
+static void drainKeys(RadixTask* task) {
+	for (int i = task->begin; i < task->end; i++) {
+		task->indexes[i] = (int) (task->source->indexes[i] ^ SIGN_BIT_32);
+		task->values[i] = keyToValue(task->source->values[i]);
+	}
+}
+
+static void* runTask(void* argument) {
+	RadixTask* task = (RadixTask*) argument;
+	switch (task->phase) {
+	case FILL_PHASE:
+		fillKeys(task);
+		break;
+	case COUNT_PHASE:
+		countDigits(task);
+		break;
+	case SCATTER_PHASE:
+		scatterKeys(task);
+		break;
+	case DRAIN_PHASE:
+		drainKeys(task);
+		break;
+	}
+	return NULL;
+}
+
+/*
+ * Runs a phase of every task, the first on the calling thread and the others
+ * on their own threads. A task whose thread cannot be started runs on the
+ * calling thread instead.
+ */
+static void runPhase(RadixTask* tasks, pthread_t* ids, bool* started, int threads,
+		RadixPhase phase) {
+	for (int t = 0; t < threads; t++) {
+		tasks[t].phase = phase;
+	}
+	for (int t = 1; t < threads; t++) {
+		started[t] = pthread_create(&ids[t], NULL, runTask, &tasks[t]) == 0;
+	}
+	runTask(&tasks[0]);
+	for (int t = 1; t < threads; t++) {
+		if (started[t]) {
+			pthread_join(ids[t], NULL);
+		} else {
+			runTask(&tasks[t]);
+		}
+	}
+}
+
+/*
+ * Turns the digit counts of every block into the first position of every
+ * digit in every block: the elements of a digit come after all smaller
+ * digits, and within a digit the blocks keep their order. Returns false if
+ * all the elements share a single digit, in which case the pass is not needed.
+ */
+static bool computeOffsets(RadixTask* tasks, int threads, int pass, int n) {
+	int position = 0;
+	for (int digit = 0; digit < BUCKETS; digit++) {
+		int total = 0;
+		for (int t = 0; t < threads; t++) {
+			total += tasks[t].counts[pass][digit];
+		}
+		if (total == n) {
+			return false;
+		}
+		for (int t = 0; t < threads; t++) {
+			int count = tasks[t].counts[pass][digit];
+			tasks[t].counts[pass][digit] = position;
+			position += count;
+		}
+	}
+	return true;
+}
+
+/*
+ * Sorts the elements of the tasks' arrays, given the tasks' blocks and the
+ * two key buffers.
+ */
+static void sortBlocks(RadixTask* tasks, pthread_t* ids, bool* started, int threads,
+		int n) {
+	runPhase(tasks, ids, started, threads, FILL_PHASE);
+	// The counts of the fill phase hold for every pass until keys move between blocks
+	bool moved = false;
+	for (int pass = 0; pass < PASSES; pass++) {
+		for (int t = 0; t < threads; t++) {
+			tasks[t].pass = pass;
+		}
+		if (moved && threads > 1) {
+			runPhase(tasks, ids, started, threads, COUNT_PHASE);
+		}
+		if (!computeOffsets(tasks, threads, pass, n)) {
+			continue;
+		}
+		runPhase(tasks, ids, started, threads, SCATTER_PHASE);
+		for (int t = 0; t < threads; t++) {
+			Keys* swap = tasks[t].source;
+			tasks[t].source = tasks[t].target;
+			tasks[t].target = swap;
+		}
+		moved = true;
+	}
+	runPhase(tasks, ids, started, threads, DRAIN_PHASE);
+}
+
+SP_RADIX_SORT_MSG spRadixSortParallel(int* indexes, double* values, int n, int threads) {
+	if (n < 0 || threads < 1 || (n > 0 && (!indexes || !values))) {	// Invalid input
+		return SP_RADIX_SORT_INVALID_ARGUMENT;
+	}
+	if (n < 2) {
+		return SP_RADIX_SORT_SUCCESS;
+	}
+	if (threads > n) {
+		threads = n;
+	}
+	Keys buffers[2];
+	buffers[0].indexes = (uint32_t*) malloc(sizeof(uint32_t) * n);
+	buffers[0].values = (uint64_t*) malloc(sizeof(uint64_t) * n);
+	buffers[1].indexes = (uint32_t*) malloc(sizeof(uint32_t) * n);
+	buffers[1].values = (uint64_t*) malloc(sizeof(uint64_t) * n);
+	RadixTask* tasks = (RadixTask*) malloc(sizeof(RadixTask) * threads);
+	pthread_t* ids = (pthread_t*) malloc(sizeof(pthread_t) * threads);
+	bool* started = (bool*) malloc(sizeof(bool) * threads);
+	bool allocated = buffers[0].indexes && buffers[0].values && buffers[1].indexes &&
+			buffers[1].values && tasks && ids && started;
+	if (allocated) {
+		for (int t = 0; t < threads; t++) {
+			tasks[t].begin = (int) ((long long) n * t / threads);
+			tasks[t].end = (int) ((long long) n * (t + 1) / threads);
+			tasks[t].source = &buffers[0];
+			tasks[t].target = &buffers[1];
+			tasks[t].indexes = indexes;
+			tasks[t].values = values;
+		}
+		sortBlocks(tasks, ids, started, threads, n);
+	}
+	free(buffers[0].indexes);
+	free(buffers[0].values);
+	free(buffers[1].indexes);
+	free(buffers[1].values);
+	free(tasks);
+	free(ids);
+	free(started);
+	return allocated ? SP_RADIX_SORT_SUCCESS : SP_RADIX_SORT_OUT_OF_MEMORY;
+}
+
+SP_RADIX_SORT_MSG spRadixSort(int* indexes, double* values, int n) {
+	return spRadixSortParallel(indexes, values, n, 1);
+}
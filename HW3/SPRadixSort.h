@@ -0,0 +1,74 @@
+#ifndef SPRADIXSORT_H_
+#define SPRADIXSORT_H_
+/**
+ * Radix Sort Summary
+ *
+ * Sorts elements given as a structure of arrays (an array of indexes and an
+ * array of values, where element i is (indexes[i], values[i])) in the order
+ * of spListElementCompare: by value, and elements with equal values by index.
+ *
+ * The sort is a least significant digit radix sort over 8 bit digits. Each
+ * element is mapped to an unsigned key - the bit pattern of the value, with
+ * the sign bit flipped (all bits are flipped for negative values), and the
+ * index with its sign bit flipped - so that comparing keys orders elements
+ * as spListElementCompare does. The elements are first sorted by the digits
+ * of the index and then, stably, by the digits of the value. Each pass reads
+ * and writes the keys sequentially, so the sort takes O(n) time and runs
+ * close to memory bandwidth. Passes in which all the elements share the same
+ * digit (e.g. the upper digits of small indexes) are skipped.
+ *
+ * spRadixSortParallel splits every pass between threads: each thread counts
+ * the digits of a contiguous block of elements, and after the counts are
+ * combined each thread moves its block to the positions the counts give.
+ *
+ * -0.0 equals 0.0 in spListElementCompare, so it is sorted (and written back)
+ * as 0.0. NaN values are not supported.
+ *
+ * The following functions are available:
+ *
+ *   spRadixSort			- Sorts elements given as arrays.
+ *   spRadixSortParallel	- Sorts elements given as arrays using several threads.
+ */
+
+/** Type used for returning error codes from radix sort functions **/
+typedef enum sp_radix_sort_msg_t {
+	SP_RADIX_SORT_SUCCESS,
+	SP_RADIX_SORT_INVALID_ARGUMENT,
+	SP_RADIX_SORT_OUT_OF_MEMORY
+} SP_RADIX_SORT_MSG;
+
+/**
+ * Sorts the elements (indexes[i], values[i]) in the order of
+ * spListElementCompare. The two arrays are permuted together. Takes O(n) time
+ * and O(n) extra memory.
+ *
+ * @param indexes - The indexes of the elements.
+ * @param values - The values of the elements.
+ * @param n - The number of elements.
+ * @return
+ * SP_RADIX_SORT_INVALID_ARGUMENT if n < 0, or if n > 0 and an array is NULL;
+ * SP_RADIX_SORT_OUT_OF_MEMORY in case of a memory allocation failure, in
+ * 	which case the arrays are not changed;
+ * SP_RADIX_SORT_SUCCESS otherwise.
+ */
+SP_RADIX_SORT_MSG spRadixSort(int* indexes, double* values, int n);
+
+/**
+ * Same as spRadixSort, but every pass is split between the given number of
+ * threads. If a thread cannot be started, its share of the work is done by
+ * the calling thread.
+ *
+ * @param indexes - The indexes of the elements.
+ * @param values - The values of the elements.
+ * @param n - The number of elements.
+ * @param threads - The number of threads to use, including the calling thread.
+ * @return
+ * SP_RADIX_SORT_INVALID_ARGUMENT if n < 0 or threads < 1, or if n > 0 and an
+ * 	array is NULL;
+ * SP_RADIX_SORT_OUT_OF_MEMORY in case of a memory allocation failure, in
+ * 	which case the arrays are not changed;
+ * SP_RADIX_SORT_SUCCESS otherwise.
+ */
+SP_RADIX_SORT_MSG spRadixSortParallel(int* indexes, double* values, int n, int threads);
+
+#endif /* SPRADIXSORT_H_ */
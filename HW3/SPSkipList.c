@@ -0,0 +1,335 @@
+#include "SPSkipList.h"
+#include <stdlib.h>
+
+#define MAX_LEVEL 32
+#define RANDOM_SEED 2463534242u
+
+typedef struct skip_node_t* SkipNode;
+
+/** A forward link, and the number of level 0 steps it skips **/
+typedef struct skip_link_t {
+	SkipNode forward;
+	int span;
+} SkipLink;
+
+struct skip_node_t {
+	SPListElementValue data;
+	SkipNode backward;
+	SkipLink links[];		// One link per level of the node
+};
+
+struct sp_skip_list_t {
+	SkipNode header;		// Has MAX_LEVEL links, its data is unused
+	SkipNode tail;
+	SkipNode current;
+	int level;
+	int size;
+	unsigned int random;	// xorshift32 state
+};
+
+static int compare(const SPListElementValue* e1,
+		const SPListElementValue* e2) {
+	return spListElementValueCompare(*e1, *e2);
+}
+
+static SkipNode createNode(int level) {
+	return (SkipNode) malloc(sizeof(struct skip_node_t) + sizeof(SkipLink) * level);
+}
+
+/*
+ * Draws the level of a new node: 1, and one more level with probability
+ * 1/4 for each level.
+ */
+static int randomLevel(SPSkipList list) {
+	int level = 1;
+	list->random ^= list->random << 13;
+	list->random ^= list->random >> 17;
+	list->random ^= list->random << 5;
+	for (unsigned int bits = list->random; (bits & 3) == 0 && level < MAX_LEVEL;
+			bits >>= 2) {
+		level++;
+	}
+	return level;
+}
+
+/*
+ * Fills update with the last node on each level which is less than element
+ * (strict is true) or not greater than element (strict is false). Returns
+ * the number of elements up to and including update[0].
+ */
+static int findPredecessors(SPSkipList list, const SPListElementValue* element,
+		bool strict, SkipNode* update, int* ranks) {
+	SkipNode node = list->header;
+	int rank = 0;
+	for (int i = list->level - 1; i >= 0; i--) {
+		SkipNode next;
+		while ((next = node->links[i].forward) != NULL &&
+				compare(&next->data, element) < (strict ? 0 : 1)) {
+			rank += node->links[i].span;
+			node = next;
+		}
+		update[i] = node;
+		if (ranks != NULL) {
+			ranks[i] = rank;
+		}
+	}
+	return rank;
+}
+
+static void removeNode(SPSkipList list, SkipNode node, SkipNode* update) {
+	for (int i = 0; i < list->level; i++) {
+		if (update[i]->links[i].forward == node) {
+			update[i]->links[i].span += node->links[i].span - 1;
+			update[i]->links[i].forward = node->links[i].forward;
+		} else {
+			update[i]->links[i].span--;
+		}
+	}
+	if (node->links[0].forward != NULL) {
+		node->links[0].forward->backward = node->backward;
+	} else {
+		list->tail = node->backward;
+	}
+	while (list->level > 1 && list->header->links[list->level - 1].forward == NULL) {
+		list->level--;
+	}
+	list->size--;
+	list->current = NULL;
+	free(node);
+}
+
+SPSkipList spSkipListCreate() {
+	SPSkipList list = (SPSkipList) malloc(sizeof(*list));
+	if (list == NULL) {
+		return NULL;
+	}
+	list->header = createNode(MAX_LEVEL);
+	if (list->header == NULL) {
+		free(list);
+		return NULL;
+	}
+	for (int i = 0; i < MAX_LEVEL; i++) {
+		list->header->links[i].forward = NULL;
+		list->header->links[i].span = 0;
+	}
+	list->header->backward = NULL;
+	list->tail = NULL;
+	list->current = NULL;
+	list->level = 1;
+	list->size = 0;
+	list->random = RANDOM_SEED;
+	return list;
+}
+
+void spSkipListDestroy(SPSkipList list) {
+	if (list == NULL) {
+		return;
+	}
+	spSkipListClear(list);
+	free(list->header);
+	free(list);
+}
+
+SP_SKIP_LIST_MSG spSkipListClear(SPSkipList list) {
+	if (list == NULL) {
+		return SP_SKIP_LIST_NULL_ARGUMENT;
+	}
+	SkipNode node = list->header->links[0].forward;
+	while (node != NULL) {
+		SkipNode next = node->links[0].forward;
+		free(node);
+		node = next;
+	}
+	for (int i = 0; i < MAX_LEVEL; i++) {
+		list->header->links[i].forward = NULL;
+		list->header->links[i].span = 0;
+	}
+	list->tail = NULL;
+	list->current = NULL;
+	list->level = 1;
+	list->size = 0;
+	return SP_SKIP_LIST_SUCCESS;
+}
+
+int spSkipListGetSize(SPSkipList list) {
+	return list == NULL ? -1 : list->size;
+}
+
+SP_SKIP_LIST_MSG spSkipListInsert(SPSkipList list, SPListElement element) {
+	SkipNode update[MAX_LEVEL];
+	int ranks[MAX_LEVEL];
+	if (list == NULL || element == NULL) {
+		return SP_SKIP_LIST_NULL_ARGUMENT;
+	}
+	int rank = findPredecessors(list, element, false, update, ranks);
+	int level = randomLevel(list);
+	SkipNode node = createNode(level);
+	if (node == NULL) {
+		return SP_SKIP_LIST_OUT_OF_MEMORY;
+	}
+	for (int i = list->level; i < level; i++) {
+		ranks[i] = 0;
+		update[i] = list->header;
+		update[i]->links[i].span = list->size;
+	}
+	if (level > list->level) {
+		list->level = level;
+	}
+	node->data = *element;
+	for (int i = 0; i < level; i++) {
+		node->links[i].forward = update[i]->links[i].forward;
+		update[i]->links[i].forward = node;
+		node->links[i].span = update[i]->links[i].span - (rank - ranks[i]);
+		update[i]->links[i].span = rank - ranks[i] + 1;
+	}
+	for (int i = level; i < list->level; i++) {
+		update[i]->links[i].span++;
+	}
+	node->backward = update[0] == list->header ? NULL : update[0];
+	if (node->links[0].forward != NULL) {
+		node->links[0].forward->backward = node;
+	} else {
+		list->tail = node;
+	}
+	list->size++;
+	return SP_SKIP_LIST_SUCCESS;
+}
+
+SP_SKIP_LIST_MSG spSkipListRemove(SPSkipList list, SPListElement element) {
+	SkipNode update[MAX_LEVEL];
+	if (list == NULL || element == NULL) {
+		return SP_SKIP_LIST_NULL_ARGUMENT;
+	}
+	findPredecessors(list, element, true, update, NULL);
+	SkipNode node = update[0]->links[0].forward;
+	if (node == NULL || compare(&node->data, element) != 0) {
+		return SP_SKIP_LIST_NOT_FOUND;
+	}
+	removeNode(list, node, update);
+	return SP_SKIP_LIST_SUCCESS;
+}
+
+bool spSkipListContains(SPSkipList list, SPListElement element) {
+	SkipNode update[MAX_LEVEL];
+	if (list == NULL || element == NULL) {
+		return false;
+	}
+	findPredecessors(list, element, true, update, NULL);
+	SkipNode node = update[0]->links[0].forward;
+	return node != NULL && compare(&node->data, element) == 0;
+}
+
+int spSkipListRank(SPSkipList list, SPListElement element) {
+	SkipNode update[MAX_LEVEL];
+	if (list == NULL || element == NULL) {
+		return -1;
+	}
+	return findPredecessors(list, element, true, update, NULL);
+}
+
+SPListElement spSkipListGetAt(SPSkipList list, int rank) {
+	if (list == NULL || rank < 0 || rank >= list->size) {
+		return NULL;
+	}
+	SkipNode node = list->header;
+	int traversed = 0;
+	for (int i = list->level - 1; i >= 0; i--) {
+		while (node->links[i].forward != NULL &&
+				traversed + node->links[i].span <= rank + 1) {
+			traversed += node->links[i].span;
+			node = node->links[i].forward;
+		}
+		if (traversed == rank + 1) {
+			break;
+		}
+	}
+	return &node->data;
+}
+
+SPListElement spSkipListGetMin(SPSkipList list) {
+	if (list == NULL || list->size == 0) {
+		return NULL;
+	}
+	return &list->header->links[0].forward->data;
+}
+
+SPListElement spSkipListGetMax(SPSkipList list) {
+	if (list == NULL || list->size == 0) {
+		return NULL;
+	}
+	return &list->tail->data;
+}
+
+SP_SKIP_LIST_MSG spSkipListRemoveMin(SPSkipList list) {
+	SkipNode update[MAX_LEVEL];
+	if (list == NULL) {
+		return SP_SKIP_LIST_NULL_ARGUMENT;
+	}
+	if (list->size == 0) {
+		return SP_SKIP_LIST_EMPTY;
+	}
+	for (int i = 0; i < list->level; i++) {	// The header precedes the minimum
+		update[i] = list->header;
+	}
+	removeNode(list, list->header->links[0].forward, update);
+	return SP_SKIP_LIST_SUCCESS;
+}
+
+SP_SKIP_LIST_MSG spSkipListRemoveMax(SPSkipList list) {
+	SkipNode update[MAX_LEVEL];
+	if (list == NULL) {
+		return SP_SKIP_LIST_NULL_ARGUMENT;
+	}
+	if (list->size == 0) {
+		return SP_SKIP_LIST_EMPTY;
+	}
+	// The tail is the last of its equal elements, and is found after them
+	findPredecessors(list, &list->tail->data, true, update, NULL);
+	for (int i = 0; i < list->level; i++) {
+		while (update[i]->links[i].forward != NULL &&
+				update[i]->links[i].forward != list->tail) {
+			update[i] = update[i]->links[i].forward;
+		}
+	}
+	removeNode(list, list->tail, update);
+	return SP_SKIP_LIST_SUCCESS;
+}
+
+SPListElement spSkipListGetFirst(SPSkipList list) {
+	if (list == NULL || list->size == 0) {
+		return NULL;
+	}
+	list->current = list->header->links[0].forward;
+	return &list->current->data;
+}
+
+SPListElement spSkipListGetLast(SPSkipList list) {
+	if (list == NULL || list->size == 0) {
+		return NULL;
+	}
+	list->current = list->tail;
+	return &list->current->data;
+}
+
+SPListElement spSkipListGetNext(SPSkipList list) {
+	if (list == NULL || list->current == NULL) {
+		return NULL;
+	}
+	list->current = list->current->links[0].forward;
+	return list->current == NULL ? NULL : &list->current->data;
+}
+
+SPListElement spSkipListGetPrevious(SPSkipList list) {
+	if (list == NULL || list->current == NULL) {
+		return NULL;
+	}
+	list->current = list->current->backward;
+	return list->current == NULL ? NULL : &list->current->data;
+}
+
+SPListElement spSkipListGetCurrent(SPSkipList list) {
+	if (list == NULL || list->current == NULL) {
+		return NULL;
+	}
+	return &list->current->data;
+}
@@ -0,0 +1,250 @@
+#ifndef SPSKIPLIST_H_
+#define SPSKIPLIST_H_
+#include "SPListElement.h"
+#include <stdbool.h>
+/**
+ * Skip List Summary
+ *
+ * An ordered container of list elements, sorted by spListElementCompare.
+ * Equal elements may appear more than once, in insertion order.
+ *
+ * Every node stores its element by value together with a compact array of
+ * forward links, one per level of the node. Levels are drawn at random
+ * (each level is kept with probability 1/4), so search, insertion and
+ * removal take O(log n) on average. Each link also records how many
+ * elements it skips, which gives the rank of an element and the element of
+ * a given rank in O(log n). The minimal and maximal elements are found in
+ * O(1).
+ *
+ * The skip list has an internal iterator which visits the elements in order.
+ * Insertions do not move the iterator; any removal makes it undefined.
+ * Elements returned by the skip list are owned by it and must not be
+ * destroyed. They are valid until they are removed.
+ *
+ * The following functions are available:
+ *
+ *   spSkipListCreate		- Creates a new empty skip list.
+ *   spSkipListDestroy		- Frees all memory allocations associated with a skip list.
+ *   spSkipListClear		- Clears all elements from a skip list.
+ *   spSkipListGetSize		- Returns the current number of elements.
+ *   spSkipListInsert		- Inserts a copy of an element in order.
+ *   spSkipListRemove		- Removes an element equal to a given element.
+ *   spSkipListContains		- Decides whether an element is in a skip list.
+ *   spSkipListRank			- Returns the number of elements less than a given element.
+ *   spSkipListGetAt		- Returns the element of a given rank.
+ *   spSkipListGetMin		- Returns the minimal element.
+ *   spSkipListGetMax		- Returns the maximal element.
+ *   spSkipListRemoveMin	- Removes the minimal element.
+ *   spSkipListRemoveMax	- Removes the maximal element.
+ *   spSkipListGetFirst		- Sets the iterator to the minimal element and returns it.
+ *   spSkipListGetLast		- Sets the iterator to the maximal element and returns it.
+ *   spSkipListGetNext		- Advances the iterator to the next element and returns it.
+ *   spSkipListGetPrevious	- Moves the iterator to the previous element and returns it.
+ *   spSkipListGetCurrent	- Returns the element pointed by the iterator.
+ */
+
+/** Type for defining the skip list **/
+typedef struct sp_skip_list_t* SPSkipList;
+
+/** Type used for returning error codes from skip list functions **/
+typedef enum sp_skip_list_msg_t {
+	SP_SKIP_LIST_SUCCESS,
+	SP_SKIP_LIST_NULL_ARGUMENT,
+	SP_SKIP_LIST_OUT_OF_MEMORY,
+	SP_SKIP_LIST_EMPTY,
+	SP_SKIP_LIST_NOT_FOUND
+} SP_SKIP_LIST_MSG;
+
+/**
+ * Creates a new empty skip list.
+ *
+ * @return
+ * NULL in case of a memory allocation failure;
+ * The new skip list otherwise.
+ */
+SPSkipList spSkipListCreate();
+
+/**
+ * Frees all memory allocations associated with a skip list.
+ * Does nothing if given a NULL argument.
+ *
+ * @param list - The skip list to be destroyed.
+ */
+void spSkipListDestroy(SPSkipList list);
+
+/**
+ * Removes all elements from a skip list.
+ *
+ * @param list - The skip list to be cleared.
+ * @return
+ * SP_SKIP_LIST_NULL_ARGUMENT if a NULL was sent;
+ * SP_SKIP_LIST_SUCCESS otherwise.
+ */
+SP_SKIP_LIST_MSG spSkipListClear(SPSkipList list);
+
+/**
+ * Returns the number of elements in a skip list.
+ *
+ * @param list - The query skip list.
+ * @return
+ * -1 if a NULL was sent;
+ * The number of elements otherwise.
+ */
+int spSkipListGetSize(SPSkipList list);
+
+/**
+ * Inserts a copy of an element into a skip list, after all the elements
+ * which are not greater than it. The iterator is not changed.
+ *
+ * @param list - The target skip list.
+ * @param element - The element to insert.
+ * @return
+ * SP_SKIP_LIST_NULL_ARGUMENT if a NULL was sent as list or element;
+ * SP_SKIP_LIST_OUT_OF_MEMORY in case of a memory allocation failure;
+ * SP_SKIP_LIST_SUCCESS otherwise.
+ */
+SP_SKIP_LIST_MSG spSkipListInsert(SPSkipList list, SPListElement element);
+
+/**
+ * Removes one element which is equal to the given element (i.e. has the same
+ * index and value). The iterator is undefined afterwards.
+ *
+ * @param list - The target skip list.
+ * @param element - The element to remove.
+ * @return
+ * SP_SKIP_LIST_NULL_ARGUMENT if a NULL was sent as list or element;
+ * SP_SKIP_LIST_NOT_FOUND if no equal element is in the skip list;
+ * SP_SKIP_LIST_SUCCESS otherwise.
+ */
+SP_SKIP_LIST_MSG spSkipListRemove(SPSkipList list, SPListElement element);
+
+/**
+ * Decides whether an element equal to the given element is in a skip list.
+ *
+ * @param list - The query skip list.
+ * @param element - The element to search for.
+ * @return
+ * false if a NULL was sent or no equal element is in the skip list;
+ * true otherwise.
+ */
+bool spSkipListContains(SPSkipList list, SPListElement element);
+
+/**
+ * Returns the number of elements of a skip list which are less than the
+ * given element. If the element is in the skip list, this is its rank
+ * (starting from 0); otherwise this is the rank it would be inserted at.
+ *
+ * @param list - The query skip list.
+ * @param element - The query element.
+ * @return
+ * -1 if a NULL was sent;
+ * The number of elements less than element otherwise.
+ */
+int spSkipListRank(SPSkipList list, SPListElement element);
+
+/**
+ * Returns the element of the given rank, where rank 0 is the minimal element.
+ *
+ * @param list - The query skip list.
+ * @param rank - The rank of the requested element.
+ * @return
+ * NULL if a NULL was sent or rank is not in [0, size);
+ * The element of the given rank otherwise.
+ */
+SPListElement spSkipListGetAt(SPSkipList list, int rank);
+
+/**
+ * Returns the minimal element of a skip list.
+ *
+ * @param list - The query skip list.
+ * @return
+ * NULL if a NULL was sent or the skip list is empty;
+ * The minimal element otherwise.
+ */
+SPListElement spSkipListGetMin(SPSkipList list);
+
+/**
+ * Returns the maximal element of a skip list.
+ *
+ * @param list - The query skip list.
+ * @return
+ * NULL if a NULL was sent or the skip list is empty;
+ * The maximal element otherwise.
+ */
+SPListElement spSkipListGetMax(SPSkipList list);
+
+/**
+ * Removes the minimal element of a skip list. The iterator is undefined
+ * afterwards.
+ *
+ * @param list - The target skip list.
+ * @return
+ * SP_SKIP_LIST_NULL_ARGUMENT if a NULL was sent;
+ * SP_SKIP_LIST_EMPTY if the skip list is empty;
+ * SP_SKIP_LIST_SUCCESS otherwise.
+ */
+SP_SKIP_LIST_MSG spSkipListRemoveMin(SPSkipList list);
+
+/**
+ * Removes the maximal element of a skip list. The iterator is undefined
+ * afterwards.
+ *
+ * @param list - The target skip list.
+ * @return
+ * SP_SKIP_LIST_NULL_ARGUMENT if a NULL was sent;
+ * SP_SKIP_LIST_EMPTY if the skip list is empty;
+ * SP_SKIP_LIST_SUCCESS otherwise.
+ */
+SP_SKIP_LIST_MSG spSkipListRemoveMax(SPSkipList list);
+
+/**
+ * Sets the iterator to the minimal element and returns it.
+ *
+ * @param list - The query skip list.
+ * @return
+ * NULL if a NULL was sent or the skip list is empty;
+ * The minimal element otherwise.
+ */
+SPListElement spSkipListGetFirst(SPSkipList list);
+
+/**
+ * Sets the iterator to the maximal element and returns it.
+ *
+ * @param list - The query skip list.
+ * @return
+ * NULL if a NULL was sent or the skip list is empty;
+ * The maximal element otherwise.
+ */
+SPListElement spSkipListGetLast(SPSkipList list);
+
+/**
+ * Advances the iterator to the next element in order and returns it.
+ *
+ * @param list - The query skip list.
+ * @return
+ * NULL if a NULL was sent, the iterator is undefined or reached the end;
+ * The next element otherwise.
+ */
+SPListElement spSkipListGetNext(SPSkipList list);
+
+/**
+ * Moves the iterator to the previous element in order and returns it.
+ *
+ * @param list - The query skip list.
+ * @return
+ * NULL if a NULL was sent, the iterator is undefined or reached the beginning;
+ * The previous element otherwise.
+ */
+SPListElement spSkipListGetPrevious(SPSkipList list);
+
+/**
+ * Returns the element pointed by the iterator.
+ *
+ * @param list - The query skip list.
+ * @return
+ * NULL if a NULL was sent or the iterator is undefined;
+ * The current element otherwise.
+ */
+SPListElement spSkipListGetCurrent(SPSkipList list);
+
+#endif /* SPSKIPLIST_H_ */
@@ -0,0 +1,290 @@
+#include "SPUnrolledList.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * With 16 byte elements a chunk of 6 elements and its header take 128
+ * bytes, i.e. two cache lines.
+ */
+#define CHUNK_CAPACITY 6
+
+typedef struct chunk_t {
+	struct chunk_t* next;
+	struct chunk_t* previous;
+	int count;
+	SPListElementValue elements[CHUNK_CAPACITY];
+}*Chunk;
+
+struct sp_unrolled_list_t {
+	Chunk first;
+	Chunk last;
+	Chunk current;		// NULL if the iterator is invalid
+	int position;		// The position of the current element in its chunk
+	int size;
+};
+
+/*
+ * Allocates an empty chunk and links it right after previous (or as the
+ * first chunk if previous is NULL).
+ */
+static Chunk createChunkAfter(SPUnrolledList list, Chunk previous) {
+	Chunk chunk = (Chunk) malloc(sizeof(*chunk));
+	if (chunk == NULL) {
+		return NULL;
+	}
+	chunk->count = 0;
+	chunk->previous = previous;
+	chunk->next = previous == NULL ? list->first : previous->next;
+	if (chunk->next != NULL) {
+		chunk->next->previous = chunk;
+	} else {
+		list->last = chunk;
+	}
+	if (previous != NULL) {
+		previous->next = chunk;
+	} else {
+		list->first = chunk;
+	}
+	return chunk;
+}
+
+static void unlinkChunk(SPUnrolledList list, Chunk chunk) {
+	if (chunk->previous != NULL) {
+		chunk->previous->next = chunk->next;
+	} else {
+		list->first = chunk->next;
+	}
+	if (chunk->next != NULL) {
+		chunk->next->previous = chunk->previous;
+	} else {
+		list->last = chunk->previous;
+	}
+	free(chunk);
+}
+
+/*
+ * Inserts a copy of element at the given position of a chunk (or into a
+ * new chunk if the list is empty). A full chunk is split in two, except when
+ * appending to it, in which case a new chunk is started. The iterator keeps
+ * pointing to the same element.
+ */
+static SP_LIST_MSG insertAt(SPUnrolledList list, Chunk chunk, int position,
+		SPListElement element) {
+	if (chunk == NULL) {
+		chunk = createChunkAfter(list, NULL);
+		if (chunk == NULL) {
+			return SP_LIST_OUT_OF_MEMORY;
+		}
+	} else if (chunk->count == CHUNK_CAPACITY) {
+		Chunk next = createChunkAfter(list, chunk);
+		if (next == NULL) {
+			return SP_LIST_OUT_OF_MEMORY;
+		}
+		if (position == CHUNK_CAPACITY) {
+			chunk = next;
+			position = 0;
+		} else {
+			int half = CHUNK_CAPACITY / 2;
+			memcpy(next->elements, chunk->elements + half,
+					sizeof(SPListElementValue) * (CHUNK_CAPACITY - half));
+			next->count = CHUNK_CAPACITY - half;
+			chunk->count = half;
+			if (list->current == chunk && list->position >= half) {
+				list->current = next;
+				list->position -= half;
+			}
+			if (position > half) {
+				chunk = next;
+				position -= half;
+			}
+		}
+	}
+	memmove(chunk->elements + position + 1, chunk->elements + position,
+			sizeof(SPListElementValue) * (chunk->count - position));
+	chunk->elements[position] = *element;
+	chunk->count++;
+	if (list->current == chunk && list->position >= position) {
+		list->position++;
+	}
+	list->size++;
+	return SP_LIST_SUCCESS;
+}
+
+SPUnrolledList spUnrolledListCreate() {
+	SPUnrolledList list = (SPUnrolledList) malloc(sizeof(*list));
+	if (list == NULL) {
+		return NULL;
+	}
+	list->first = NULL;
+	list->last = NULL;
+	list->current = NULL;
+	list->position = 0;
+	list->size = 0;
+	return list;
+}
+
+SPUnrolledList spUnrolledListCopy(SPUnrolledList list) {
+	if (list == NULL) {
+		return NULL;
+	}
+	SPUnrolledList copyList = spUnrolledListCreate();
+	if (copyList == NULL) {
+		return NULL;
+	}
+	for (Chunk chunk = list->first; chunk != NULL; chunk = chunk->next) {
+		Chunk copy = createChunkAfter(copyList, copyList->last);
+		if (copy == NULL) {
+			spUnrolledListDestroy(copyList);
+			return NULL;
+		}
+		memcpy(copy->elements, chunk->elements,
+				sizeof(SPListElementValue) * chunk->count);
+		copy->count = chunk->count;
+	}
+	copyList->size = list->size;
+	return copyList;
+}
+
+int spUnrolledListGetSize(SPUnrolledList list) {
+	return list == NULL ? -1 : list->size;
+}
+
+SPListElement spUnrolledListGetFirst(SPUnrolledList list) {
+	if (list == NULL || list->size == 0) {
+		return NULL;
+	}
+	list->current = list->first;
+	list->position = 0;
+	return &list->current->elements[0];
+}
+
+SPListElement spUnrolledListGetLast(SPUnrolledList list) {
+	if (list == NULL || list->size == 0) {
+		return NULL;
+	}
+	list->current = list->last;
+	list->position = list->last->count - 1;
+	return &list->current->elements[list->position];
+}
+
+SPListElement spUnrolledListGetNext(SPUnrolledList list) {
+	if (list == NULL || list->current == NULL) {
+		return NULL;
+	}
+	list->position++;
+	if (list->position == list->current->count) {
+		list->current = list->current->next;
+		list->position = 0;
+		if (list->current == NULL) {
+			return NULL;
+		}
+	}
+	return &list->current->elements[list->position];
+}
+
+SPListElement spUnrolledListGetPrevious(SPUnrolledList list) {
+	if (list == NULL || list->current == NULL) {
+		return NULL;
+	}
+	if (list->position == 0) {
+		list->current = list->current->previous;
+		if (list->current == NULL) {
+			return NULL;
+		}
+		list->position = list->current->count;
+	}
+	list->position--;
+	return &list->current->elements[list->position];
+}
+
+SPListElement spUnrolledListGetCurrent(SPUnrolledList list) {
+	if (list == NULL || list->current == NULL) {
+		return NULL;
+	}
+	return &list->current->elements[list->position];
+}
+
+SP_LIST_MSG spUnrolledListInsertFirst(SPUnrolledList list, SPListElement element) {
+	if (list == NULL || element == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	return insertAt(list, list->first, 0, element);
+}
+
+SP_LIST_MSG spUnrolledListInsertLast(SPUnrolledList list, SPListElement element) {
+	if (list == NULL || element == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	return insertAt(list, list->last, list->last == NULL ? 0 : list->last->count,
+			element);
+}
+
+SP_LIST_MSG spUnrolledListInsertBeforeCurrent(SPUnrolledList list,
+		SPListElement element) {
+	if (list == NULL || element == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	if (list->current == NULL) {
+		return SP_LIST_INVALID_CURRENT;
+	}
+	return insertAt(list, list->current, list->position, element);
+}
+
+SP_LIST_MSG spUnrolledListInsertAfterCurrent(SPUnrolledList list,
+		SPListElement element) {
+	if (list == NULL || element == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	if (list->current == NULL) {
+		return SP_LIST_INVALID_CURRENT;
+	}
+	return insertAt(list, list->current, list->position + 1, element);
+}
+
+SP_LIST_MSG spUnrolledListRemoveCurrent(SPUnrolledList list) {
+	if (list == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	if (list->current == NULL) {
+		return SP_LIST_INVALID_CURRENT;
+	}
+	Chunk chunk = list->current;
+	Chunk next = chunk->next;
+	memmove(chunk->elements + list->position, chunk->elements + list->position + 1,
+			sizeof(SPListElementValue) * (chunk->count - list->position - 1));
+	chunk->count--;
+	if (chunk->count == 0) {
+		unlinkChunk(list, chunk);
+	} else if (next != NULL && chunk->count + next->count <= CHUNK_CAPACITY) {
+		memcpy(chunk->elements + chunk->count, next->elements,
+				sizeof(SPListElementValue) * next->count);
+		chunk->count += next->count;
+		unlinkChunk(list, next);
+	}
+	list->current = NULL;
+	list->size--;
+	return SP_LIST_SUCCESS;
+}
+
+SP_LIST_MSG spUnrolledListClear(SPUnrolledList list) {
+	if (list == NULL) {
+		return SP_LIST_NULL_ARGUMENT;
+	}
+	while (list->first != NULL) {
+		Chunk next = list->first->next;
+		free(list->first);
+		list->first = next;
+	}
+	list->last = NULL;
+	list->current = NULL;
+	list->size = 0;
+	return SP_LIST_SUCCESS;
+}
+
+void spUnrolledListDestroy(SPUnrolledList list) {
+	if (list == NULL) {
+		return;
+	}
+	spUnrolledListClear(list);
+	free(list);
+}
@@ -0,0 +1,247 @@
+#ifndef SPUNROLLEDLIST_H_
+#define SPUNROLLEDLIST_H_
+
+#include <stdbool.h>
+#include "SPListElement.h"
+#include "SPList.h"
+/**
+ * Unrolled List Container Summary
+ *
+ * Implements an unrolled linked list of SPListElement. The list offers the
+ * same interface as SPList (please refer to SPList.h), including its
+ * internal iterator and its error codes, but each node of the list holds a
+ * small array of elements stored by value. A node fits in two cache lines,
+ * so iterating over the list and copying it mostly reads contiguous memory.
+ *
+ * A full node is split in two when an element is inserted into it, and a
+ * node is merged with its successor when an element is removed and both
+ * fit into one node.
+ *
+ * Elements returned by the list point into its nodes. They are owned by the
+ * list and must not be destroyed. Since elements move within and between
+ * nodes, a returned element is valid only until the list is changed.
+ *
+ * The following functions are available:
+ *
+ *   spUnrolledListCreate               - Creates a new empty list
+ *   spUnrolledListDestroy              - Deletes an existing list and frees all resources
+ *   spUnrolledListCopy                 - Copies an existing list
+ *   spUnrolledListGetSize              - Returns the size of a given list
+ *   spUnrolledListInsertFirst          - Inserts an element in the beginning of the list
+ *   spUnrolledListInsertLast           - Inserts an element in the end of the list
+ *   spUnrolledListInsertBeforeCurrent  - Inserts an element right before the place of
+ *                                        internal iterator
+ *   spUnrolledListInsertAfterCurrent   - Inserts an element right after the place of the
+ *                                        internal iterator
+ *   spUnrolledListRemoveCurrent        - Removes the element pointed by the internal
+ *                                        iterator
+ *   spUnrolledListGetCurrent           - Return the current element (pointed by the
+ *                                        internal iterator)
+ *   spUnrolledListGetFirst             - Sets the internal iterator to the first
+ *                                        element in the list and returns it.
+ *   spUnrolledListGetLast              - Sets the internal iterator to the last
+ *                                        element in the list and returns it.
+ *   spUnrolledListGetNext              - Advances the list's iterator to the next element
+ *                                        and returns it
+ *   spUnrolledListGetPrevious          - Moves the list's iterator to the previous element
+ *                                        and return it
+ *   spUnrolledListClear                - Clears all the data from the list
+ */
+
+/** Type for defining the unrolled list */
+typedef struct sp_unrolled_list_t *SPUnrolledList;
+
+/**
+ * Allocates a new unrolled list.
+ *
+ * @return
+ * 	NULL - If allocations failed.
+ * 	A new list in case of success.
+ */
+SPUnrolledList spUnrolledListCreate();
+
+/**
+ * Creates a copy of target list. The nodes of the list are copied as a whole.
+ *
+ * The new copy will contain all the elements from the source list in the same
+ * order. The internal iterator of the source list is not changed, and the
+ * internal iterator of the new copy will not be defined.
+ *
+ * @param list The target list to copy
+ * @return
+ * NULL if a NULL was sent or a memory allocation failed.
+ * A list containing the same elements with same order as list otherwise.
+ */
+SPUnrolledList spUnrolledListCopy(SPUnrolledList list);
+
+/**
+ * Returns the number of elements in a list. the iterator state will not change.
+ *
+ * @param list The target list which size is requested.
+ * @return
+ * -1 if a NULL pointer was sent.
+ * Otherwise the number of elements in the list.
+ */
+int spUnrolledListGetSize(SPUnrolledList list);
+
+/**
+ * Sets the internal iterator to the first element and retrieves it.
+ *
+ * @param list The list for which to set the iterator and return the first
+ * element.
+ * @return
+ * NULL is a NULL pointer was sent or the list is empty.
+ * The first element of the list otherwise
+ */
+SPListElement spUnrolledListGetFirst(SPUnrolledList list);
+
+/**
+ * Sets the internal iterator to the last element and retrieves it.
+ *
+ * @param list The list for which to set the iterator and return the last
+ * element.
+ * @return
+ * NULL is a NULL pointer was sent or the list is empty.
+ * The last element of the list otherwise
+ */
+SPListElement spUnrolledListGetLast(SPUnrolledList list);
+
+/**
+ * Advances the list's iterator to the next element and return it. In case
+ * the return value is NULL, the state of the iterator will not be defined,
+ * otherwise it will point to the next element in the list.
+ *
+ * @param list The list for which to advance the iterator
+ * @return
+ * NULL if reached the end of the list, the iterator is at an invalid state or
+ * a NULL sent as argument
+ * The next element on the list in case of success
+ */
+SPListElement spUnrolledListGetNext(SPUnrolledList list);
+
+/**
+ * Moves the list's iterator to the previous element and return it. In case
+ * the return value is NULL, the state of the iterator will not be defined,
+ * otherwise it will point to the previous element in the list.
+ *
+ * @param list The list for which to move the iterator
+ * @return
+ * NULL if reached the beginning of the list, the iterator is at an invalid
+ * state or a NULL sent as argument
+ * The previous element on the list in case of success
+ */
+SPListElement spUnrolledListGetPrevious(SPUnrolledList list);
+
+/**
+ * Returns the current element (pointed by the iterator)
+ *
+ * @param list The list for which to get the iterator
+ * @return
+ * NULL if the iterator is at an invalid state or a NULL sent as argument
+ * The current element on the list in case of success
+ */
+SPListElement spUnrolledListGetCurrent(SPUnrolledList list);
+
+/**
+ * Adds a new element to the list, the new element will be the first element.
+ * The iterator keeps pointing to the same element.
+ *
+ * @param list The list for which to add an element in its start
+ * @param element The element to insert. A copy of the element will be
+ * inserted
+ * @return
+ * SP_LIST_NULL_ARGUMENT if a NULL was sent as list or element
+ * SP_LIST_OUT_OF_MEMORY if an allocation failed
+ * SP_LIST_SUCCESS the element has been inserted successfully
+ */
+SP_LIST_MSG spUnrolledListInsertFirst(SPUnrolledList list, SPListElement element);
+
+/**
+ * Adds a new element to the list, the new element will be the last element.
+ * The iterator keeps pointing to the same element.
+ *
+ * @param list The list for which to add an element in its end
+ * @param element The element to insert. A copy of the element will be
+ * inserted
+ * @return
+ * SP_LIST_NULL_ARGUMENT if a NULL was sent as list or element
+ * SP_LIST_OUT_OF_MEMORY if an allocation failed
+ * SP_LIST_SUCCESS the element has been inserted successfully
+ */
+SP_LIST_MSG spUnrolledListInsertLast(SPUnrolledList list, SPListElement element);
+
+/**
+ * Adds a new element to the list, the new element will be placed right before
+ * the current element. The iterator keeps pointing to the same element.
+ *
+ * @param list The list for which to add an element before its current element
+ * @param element The element to insert. A copy of the element will be
+ * inserted
+ * @return
+ * SP_LIST_NULL_ARGUMENT if a NULL was sent as list or element
+ * SP_LIST_INVALID_CURRENT if the list's iterator is in an invalid state
+ * SP_LIST_OUT_OF_MEMORY if an allocation failed
+ * SP_LIST_SUCCESS the element has been inserted successfully
+ */
+SP_LIST_MSG spUnrolledListInsertBeforeCurrent(SPUnrolledList list, SPListElement element);
+
+/**
+ * Adds a new element to the list, the new element will be placed right after
+ * the current element. The iterator keeps pointing to the same element.
+ *
+ * @param list The list for which to add an element after its current element
+ * @param element The element to insert. A copy of the element will be
+ * inserted
+ * @return
+ * SP_LIST_NULL_ARGUMENT if a NULL was sent as list or element
+ * SP_LIST_INVALID_CURRENT if the list's iterator is in an invalid state
+ * SP_LIST_OUT_OF_MEMORY if an allocation failed
+ * SP_LIST_SUCCESS the element has been inserted successfully
+ */
+SP_LIST_MSG spUnrolledListInsertAfterCurrent(SPUnrolledList list, SPListElement element);
+
+/**
+ * Removes the currently pointed element of the list. The state of the
+ * current element will not be defined afterwards.
+ *
+ * @param list The list for which the current element will be removed
+ * @return
+ * SP_LIST_NULL_ARGUMENT if list is NULL
+ * SP_LIST_INVALID_CURRENT if the current pointer of the list is in invalid state
+ * SP_LIST_SUCCESS the current element was removed successfully
+ */
+SP_LIST_MSG spUnrolledListRemoveCurrent(SPUnrolledList list);
+
+/**
+ * Removes all elements from target list. The state of the current element
+ * will not be defined afterwards.
+ *
+ * @param list Target list to remove all element from
+ * @return
+ * SP_LIST_NULL_ARGUMENT - if a NULL pointer was sent.
+ * SP_LIST_SUCCESS - Otherwise.
+ */
+SP_LIST_MSG spUnrolledListClear(SPUnrolledList list);
+
+/**
+ * Deallocates an existing list and all its elements.
+ *
+ * @param list Target list to be deallocated. If list is NULL nothing will be
+ * done
+ */
+void spUnrolledListDestroy(SPUnrolledList list);
+
+/**
+ * Macro for iterating over an unrolled list. Same as SP_LIST_FOREACH.
+ * Note that this macro modifies the internal iterator.
+ *
+ * @param type The type of the elements in the list
+ * @param iterator The name of the variable to hold the next list element
+ * @param list the list to iterate over
+ */
+#define SP_UNROLLED_LIST_FOREACH(type,iterator,list) \
+	for(type iterator = spUnrolledListGetFirst(list) ; \
+		iterator ;\
+		iterator = spUnrolledListGetNext(list))
+
+#endif /* SPUNROLLEDLIST_H_ */
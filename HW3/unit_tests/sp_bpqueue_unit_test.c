@@ -616,6 +616,313 @@ bool bpqueueIsFullTest() {
 	FREE_ELEMENTS();
 	return true;
 }
+bool bpqueueDrainSortedTest() {
+
+	SPBPQueue queue;
+	int indexes[4];
+	double values[4];
+	int i;
+	CREATE_ELEMENTS();
+
+	queue = spBPQueueCreate(4);
+	if (spBPQueueDrainSorted(NULL, indexes, values) != SP_BPQUEUE_INVALID_ARGUMENT ||
+			spBPQueueDrainSorted(queue, NULL, values) != SP_BPQUEUE_INVALID_ARGUMENT) {
+		spBPQueueDestroy(queue);
+		FREE_ELEMENTS();
+		return false;
+	}
+
+	spBPQueueEnqueue(queue, e3);
+	spBPQueueEnqueue(queue, e5);
+	spBPQueueEnqueue(queue, e2);
+	spBPQueueEnqueue(queue, e4);
+	spBPQueueEnqueue(queue, e1);
+
+	if (spBPQueueDrainSorted(queue, indexes, values) != SP_BPQUEUE_SUCCESS ||
+			!spBPQueueIsEmpty(queue)) {
+		spBPQueueDestroy(queue);
+		FREE_ELEMENTS();
+		return false;
+	}
+	for (i=0; i<4; i++) {
+		if (indexes[i] != i+1 || values[i] != i+1) {
+			spBPQueueDestroy(queue);
+			FREE_ELEMENTS();
+			return false;
+		}
+	}
+
+	spBPQueueDestroy(queue);
+	FREE_ELEMENTS();
+	return true;
+}
+
+bool bpqueueCursorTest() {
+
+	SPBPQueue queue;
+	SPBPQueueCursor cursor;
+	SPListElement element;
+	int i = 0;
+	CREATE_ELEMENTS();
+
+	if (spBPQueueCursorCreate(NULL) != NULL || spBPQueueCursorNext(NULL) != NULL) {
+		FREE_ELEMENTS();
+		return false;
+	}
+
+	queue = spBPQueueCreate(4);
+	spBPQueueEnqueue(queue, e4);
+	spBPQueueEnqueue(queue, e2);
+	spBPQueueEnqueue(queue, e3);
+
+	cursor = spBPQueueCursorCreate(queue);
+	element = spBPQueueCursorNext(cursor);
+	while (element != NULL) {
+		// Reading the queue does not move the cursor
+		if (spListElementGetIndex(element) != i+2 || spBPQueueMaxValue(queue) != 4 ||
+				spBPQueueMinValue(queue) != 2) {
+			spBPQueueCursorDestroy(cursor);
+			spBPQueueDestroy(queue);
+			FREE_ELEMENTS();
+			return false;
+		}
+		i++;
+		element = spBPQueueCursorNext(cursor);
+	}
+	spBPQueueCursorDestroy(cursor);
+
+	if (i != 3 || spBPQueueSize(queue) != 3) {
+		spBPQueueDestroy(queue);
+		FREE_ELEMENTS();
+		return false;
+	}
+
+	spBPQueueDestroy(queue);
+	FREE_ELEMENTS();
+	return true;
+}
+bool bpqueueBuildFromArrayTest() {
+
+	SPBPQueue queue;
+	SPBPQueue expected;
+	SPListElement element;
+	int indexes[200];
+	double values[200];
+	int i, k;
+
+	for (i=0; i<200; i++) {						// Many repeated values
+		indexes[i] = (i * 37) % 200;
+		values[i] = (double) ((i * 53) % 17);
+	}
+
+	if (spBPQueueBuildFromArray(0, indexes, values, 200) != NULL ||
+			spBPQueueBuildFromArray(4, NULL, values, 200) != NULL ||
+			spBPQueueBuildFromArray(4, indexes, values, -1) != NULL) {
+		return false;
+	}
+
+	for (k=1; k<=250; k+=31) {
+		queue = spBPQueueBuildFromArray(k, indexes, values, 200);
+		expected = spBPQueueCreate(k);
+		for (i=0; i<200; i++) {
+			element = spListElementCreate(indexes[i], values[i]);
+			spBPQueueEnqueue(expected, element);
+			spListElementDestroy(element);
+		}
+		if (spBPQueueGetMaxSize(queue) != k ||
+				spBPQueueSize(queue) != spBPQueueSize(expected)) {
+			spBPQueueDestroy(queue);
+			spBPQueueDestroy(expected);
+			return false;
+		}
+		while (!spBPQueueIsEmpty(expected)) {
+			SPListElement e1 = spBPQueuePeek(queue);
+			SPListElement e2 = spBPQueuePeek(expected);
+			bool equal = spListElementCompare(e1, e2) == 0;
+			spListElementDestroy(e1);
+			spListElementDestroy(e2);
+			if (!equal) {
+				spBPQueueDestroy(queue);
+				spBPQueueDestroy(expected);
+				return false;
+			}
+			spBPQueueDequeue(queue);
+			spBPQueueDequeue(expected);
+		}
+		spBPQueueDestroy(queue);
+		spBPQueueDestroy(expected);
+	}
+
+	return true;
+}
+bool bpqueueHeapBackendTest() {
+
+	SPBPQueue list = spBPQueueCreate(8);
+	SPBPQueue heap = spBPQueueCreateWithBackend(8, SP_BPQUEUE_MINMAX_HEAP_BACKEND);
+	SPBPQueue copy;
+	SPBPQueueCursor cursor;
+	SPListElement element;
+	SPListElement fromList;
+	int copyIndexes[8], heapIndexes[8];
+	double copyValues[8], heapValues[8];
+	bool sorted = true;
+	unsigned int seed = 4242;
+	int i, size;
+
+	if (spBPQueueCreateWithBackend(8, (SP_BPQUEUE_BACKEND) 7) != NULL ||
+			spBPQueueGetBackend(heap) != SP_BPQUEUE_MINMAX_HEAP_BACKEND ||
+			spBPQueueGetBackend(list) != SP_BPQUEUE_LIST_BACKEND) {
+		spBPQueueDestroy(list);
+		spBPQueueDestroy(heap);
+		return false;
+	}
+
+	for (i=0; i<500; i++) {						// Both backends must agree
+		seed = seed * 1103515245u + 12345u;
+		element = spListElementCreate((int) ((seed >> 4) % 50), (double) ((seed >> 12) % 30));
+		if (spBPQueueEnqueue(list, element) != spBPQueueEnqueue(heap, element) ||
+				spBPQueueMinValue(list) != spBPQueueMinValue(heap) ||
+				spBPQueueMaxValue(list) != spBPQueueMaxValue(heap)) {
+			spListElementDestroy(element);
+			spBPQueueDestroy(list);
+			spBPQueueDestroy(heap);
+			return false;
+		}
+		spListElementDestroy(element);
+		if ((seed >> 20) % 4 == 0) {
+			spBPQueueDequeue(list);
+			spBPQueueDequeue(heap);
+		}
+	}
+
+	copy = spBPQueueCopy(heap);
+	size = spBPQueueSize(heap);
+	cursor = spBPQueueCursorCreate(heap);
+	for (i=0; i<size; i++) {
+		element = spBPQueueCursorNext(cursor);
+		fromList = spBPQueuePeek(list);
+		if (element == NULL || spListElementCompare(element, fromList) != 0) {
+			spListElementDestroy(fromList);
+			spBPQueueCursorDestroy(cursor);
+			spBPQueueDestroy(copy);
+			spBPQueueDestroy(list);
+			spBPQueueDestroy(heap);
+			return false;
+		}
+		spListElementDestroy(fromList);
+		spBPQueueDequeue(list);
+	}
+	element = spBPQueueCursorNext(cursor);
+	spBPQueueCursorDestroy(cursor);
+
+	spBPQueueDrainSorted(copy, copyIndexes, copyValues);
+	spBPQueueDrainSorted(heap, heapIndexes, heapValues);
+	for (i=0; i<size; i++) {
+		if ((i > 0 && heapValues[i-1] > heapValues[i]) ||
+				heapIndexes[i] != copyIndexes[i] || heapValues[i] != copyValues[i]) {
+			sorted = false;
+		}
+	}
+
+	if (element != NULL || !sorted || !spBPQueueIsEmpty(heap) || !spBPQueueIsEmpty(copy)) {
+		spBPQueueDestroy(copy);
+		spBPQueueDestroy(list);
+		spBPQueueDestroy(heap);
+		return false;
+	}
+
+	spBPQueueDestroy(copy);
+	spBPQueueDestroy(list);
+	spBPQueueDestroy(heap);
+	return true;
+}
+bool bpqueueCopyOnWriteTest() {
+
+	SP_BPQUEUE_BACKEND backends[] = { SP_BPQUEUE_LIST_BACKEND, SP_BPQUEUE_MINMAX_HEAP_BACKEND };
+	SPBPQueue queue;
+	SPBPQueue copy;
+	SPBPQueue second;
+	int indexes[4];
+	double values[4];
+	bool success = true;
+	int b;
+	CREATE_ELEMENTS();
+
+	for (b=0; b<2; b++) {
+		queue = spBPQueueCreateWithBackend(3, backends[b]);
+		spBPQueueEnqueue(queue, e2);
+		spBPQueueEnqueue(queue, e4);
+		copy = spBPQueueCopy(queue);
+		second = spBPQueueCopy(copy);
+
+		spBPQueueEnqueue(queue, e1);				// Writer changes, copies keep the snapshot
+		spBPQueueDequeue(copy);
+		success = success && spBPQueueSize(queue) == 3 && spBPQueueMinValue(queue) == 1 &&
+				spBPQueueSize(copy) == 1 && spBPQueueMinValue(copy) == 4 &&
+				spBPQueueSize(second) == 2 && spBPQueueMinValue(second) == 2 &&
+				spBPQueueGetBackend(second) == backends[b];
+
+		spBPQueueDestroy(copy);
+		copy = spBPQueueCopy(queue);
+		spBPQueueClear(queue);
+		success = success && spBPQueueIsEmpty(queue) && spBPQueueSize(copy) == 3;
+
+		spBPQueueEnqueue(queue, e5);
+		spBPQueueDestroy(second);
+		second = spBPQueueCopy(copy);
+		success = success && spBPQueueDrainSorted(copy, indexes, values) == SP_BPQUEUE_SUCCESS &&
+				spBPQueueIsEmpty(copy) && spBPQueueSize(second) == 3 &&
+				indexes[0] == 1 && indexes[1] == 2 && indexes[2] == 4 &&
+				spBPQueueMaxValue(queue) == 5;
+
+		spBPQueueDestroy(queue);
+		spBPQueueDestroy(copy);
+		spBPQueueDestroy(second);
+	}
+
+	FREE_ELEMENTS();
+	return success;
+}
+
+bool bpqueueValueTest() {
+
+	SP_BPQUEUE_BACKEND backends[] = { SP_BPQUEUE_LIST_BACKEND, SP_BPQUEUE_MINMAX_HEAP_BACKEND };
+	SPBPQueue queue;
+	SPListElementValue element;
+	bool success = true;
+	int b;
+
+	for (b=0; b<2; b++) {
+		queue = spBPQueueCreateWithBackend(3, backends[b]);
+		success = success &&
+				spBPQueueEnqueueValue(NULL, spListElementValueCreate(1, 1)) == SP_BPQUEUE_INVALID_ARGUMENT &&
+				spBPQueueEnqueueValue(queue, spListElementValueCreate(-1, 1)) == SP_BPQUEUE_INVALID_ARGUMENT &&
+				spBPQueueEnqueueValue(queue, spListElementValueCreate(1, -1)) == SP_BPQUEUE_INVALID_ARGUMENT &&
+				spBPQueuePeekValue(queue, NULL) == SP_BPQUEUE_INVALID_ARGUMENT &&
+				spBPQueuePeekValue(queue, &element) == SP_BPQUEUE_EMPTY &&
+				spBPQueuePeekLastValue(queue, &element) == SP_BPQUEUE_EMPTY;
+
+		success = success &&
+				spBPQueueEnqueueValue(queue, spListElementValueCreate(4, 4)) == SP_BPQUEUE_SUCCESS &&
+				spBPQueueEnqueueValue(queue, spListElementValueCreate(2, 2)) == SP_BPQUEUE_SUCCESS &&
+				spBPQueueEnqueueValue(queue, spListElementValueCreate(5, 2)) == SP_BPQUEUE_SUCCESS &&
+				spBPQueueEnqueueValue(queue, spListElementValueCreate(6, 4)) == SP_BPQUEUE_FULL &&
+				spBPQueueEnqueueValue(queue, spListElementValueCreate(3, 4)) == SP_BPQUEUE_SUCCESS;
+
+		success = success && spBPQueuePeekValue(queue, &element) == SP_BPQUEUE_SUCCESS &&
+				spListElementValueGetIndex(element) == 2 && spListElementValueGetValue(element) == 2;
+		success = success && spBPQueuePeekLastValue(queue, &element) == SP_BPQUEUE_SUCCESS &&
+				spListElementValueGetIndex(element) == 3 && spListElementValueGetValue(element) == 4;
+		success = success && spBPQueueMinValue(queue) == 2 && spBPQueueMaxValue(queue) == 4;
+
+		spBPQueueDequeue(queue);
+		success = success && spBPQueuePeekValue(queue, &element) == SP_BPQUEUE_SUCCESS &&
+				spListElementValueGetIndex(element) == 5;
+		spBPQueueDestroy(queue);
+	}
+
+	return success;
+}
 ///*
 int main() {
 	RUN_TEST(bpqueueCreateTest);
@@ -631,6 +938,12 @@ int main() {
 	RUN_TEST(bpqueueIsFullTest);
 	RUN_TEST(bpqueuePeekTest);
 	RUN_TEST(bpqueuePeekLastTest);
+	RUN_TEST(bpqueueDrainSortedTest);
+	RUN_TEST(bpqueueCursorTest);
+	RUN_TEST(bpqueueBuildFromArrayTest);
+	RUN_TEST(bpqueueHeapBackendTest);
+	RUN_TEST(bpqueueCopyOnWriteTest);
+	RUN_TEST(bpqueueValueTest);
 
 
 
@@ -0,0 +1,98 @@
+#include "../SPConcurrentBPQueue.h"
+#include "../SPBPriorityQueue.h"
+#include "../SPListElement.h"
+#include "unit_test_util.h"
+#include <stdbool.h>
+#include <pthread.h>
+
+#define WORKERS 4
+#define CANDIDATES_PER_WORKER 5000
+#define BOUND 16
+
+typedef struct worker_args_t {
+	SPConcurrentBPQueue queue;
+	int worker;
+} WorkerArgs;
+
+// Each worker offers a disjoint, shuffled range of indexes whose value equals the index
+static void* feedWorker(void* args) {
+	WorkerArgs* workerArgs = (WorkerArgs*) args;
+	int i, index;
+	for (i = 0; i < CANDIDATES_PER_WORKER; i++) {
+		index = (i * 7919) % CANDIDATES_PER_WORKER;
+		index = index * WORKERS + workerArgs->worker;
+		spConcurrentBPQueueOffer(workerArgs->queue, index, (double) index);
+	}
+	return NULL;
+}
+
+static bool concurrentBPQueueCreateTest() {
+	SPConcurrentBPQueue queue = spConcurrentBPQueueCreate(4);
+	ASSERT_TRUE(queue != NULL);
+	ASSERT_TRUE(spConcurrentBPQueueCreate(0) == NULL);
+	ASSERT_TRUE(spConcurrentBPQueueGetMaxSize(queue) == 4);
+	ASSERT_TRUE(spConcurrentBPQueueSize(queue) == 0);
+	ASSERT_TRUE(spConcurrentBPQueueSize(NULL) == -1);
+	spConcurrentBPQueueDestroy(queue);
+	return true;
+}
+
+static bool concurrentBPQueueThresholdTest() {
+	SPConcurrentBPQueue queue = spConcurrentBPQueueCreate(2);
+	SPListElement element = spListElementCreate(1, 1.0);
+	ASSERT_TRUE(spConcurrentBPQueueThreshold(NULL) == -1);
+	ASSERT_TRUE(spConcurrentBPQueueEnqueue(queue, NULL) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spConcurrentBPQueueOffer(queue, -1, 1.0) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spConcurrentBPQueueOffer(queue, 3, 3.0) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spConcurrentBPQueueThreshold(queue) > 1000.0);	// Not full yet
+	ASSERT_TRUE(spConcurrentBPQueueEnqueue(queue, element) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spConcurrentBPQueueThreshold(queue) == 3.0);
+	ASSERT_TRUE(spConcurrentBPQueueOffer(queue, 4, 4.0) == SP_BPQUEUE_FULL);
+	ASSERT_TRUE(spConcurrentBPQueueOffer(queue, 2, 3.0) == SP_BPQUEUE_SUCCESS); // Index tie-break
+	ASSERT_TRUE(spConcurrentBPQueueThreshold(queue) == 3.0);
+	ASSERT_TRUE(spConcurrentBPQueueOffer(queue, 5, 2.0) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spConcurrentBPQueueThreshold(queue) == 2.0);
+	spConcurrentBPQueueClear(queue);
+	ASSERT_TRUE(spConcurrentBPQueueSize(queue) == 0);
+	ASSERT_TRUE(spConcurrentBPQueueThreshold(queue) > 1000.0);
+	spListElementDestroy(element);
+	spConcurrentBPQueueDestroy(queue);
+	return true;
+}
+
+static bool concurrentBPQueueParallelFeedTest() {
+	SPConcurrentBPQueue queue = spConcurrentBPQueueCreate(BOUND);
+	pthread_t threads[WORKERS];
+	WorkerArgs args[WORKERS];
+	SPBPQueue snapshot;
+	SPListElement element;
+	int i;
+	for (i = 0; i < WORKERS; i++) {
+		args[i].queue = queue;
+		args[i].worker = i;
+		ASSERT_TRUE(pthread_create(&threads[i], NULL, feedWorker, &args[i]) == 0);
+	}
+	for (i = 0; i < WORKERS; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	ASSERT_TRUE(spConcurrentBPQueueSize(queue) == BOUND);
+	ASSERT_TRUE(spConcurrentBPQueueThreshold(queue) == BOUND - 1);
+	snapshot = spConcurrentBPQueueSnapshot(queue);
+	ASSERT_TRUE(spBPQueueSize(snapshot) == BOUND);
+	for (i = 0; i < BOUND; i++) {
+		element = spBPQueuePeek(snapshot);
+		ASSERT_TRUE(spListElementGetIndex(element) == i);
+		spListElementDestroy(element);
+		spBPQueueDequeue(snapshot);
+	}
+	spBPQueueDestroy(snapshot);
+	spConcurrentBPQueueDestroy(queue);
+	return true;
+}
+
+int main() {
+	RUN_TEST(concurrentBPQueueCreateTest);
+	RUN_TEST(concurrentBPQueueThresholdTest);
+	RUN_TEST(concurrentBPQueueParallelFeedTest);
+	return 0;
+}
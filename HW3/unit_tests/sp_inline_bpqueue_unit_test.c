@@ -0,0 +1,147 @@
+#include "../SPInlineBPQueue.h"
+#include "../SPBPriorityQueue.h"
+#include "../SPListElement.h"
+#include "../SPPackedElement.h"
+#include "unit_test_util.h"
+#include <stdbool.h>
+
+static bool inlineBPQueueEnqueueTest() {
+	SPInlineBPQueue4 queue;
+	int index;
+	double value;
+	spInlineBPQueue4Init(&queue);
+	ASSERT_TRUE(spInlineBPQueue4IsEmpty(&queue));
+	ASSERT_FALSE(spInlineBPQueue4Peek(&queue, &index, &value));
+	ASSERT_TRUE(spInlineBPQueue4MinValue(&queue) == -1);
+	ASSERT_TRUE(spInlineBPQueue4Enqueue(&queue, -1, 1.0) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spInlineBPQueue4Enqueue(&queue, 3, 3.0) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spInlineBPQueue4Enqueue(&queue, 5, 5.0) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spInlineBPQueue4Enqueue(&queue, 1, 1.0) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spInlineBPQueue4Enqueue(&queue, 4, 4.0) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spInlineBPQueue4IsFull(&queue));
+	ASSERT_TRUE(spInlineBPQueue4Enqueue(&queue, 6, 5.0) == SP_BPQUEUE_FULL);
+	ASSERT_TRUE(spInlineBPQueue4Enqueue(&queue, 2, 2.0) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spInlineBPQueue4Size(&queue) == 4);
+	ASSERT_TRUE(spInlineBPQueue4MaxValue(&queue) == 4.0);
+	ASSERT_TRUE(spInlineBPQueue4Peek(&queue, &index, &value));
+	ASSERT_TRUE(index == 1 && value == 1.0);
+	ASSERT_TRUE(spInlineBPQueue4Dequeue(&queue) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spInlineBPQueue4MinValue(&queue) == 2.0);
+	ASSERT_TRUE(spInlineBPQueue4Size(&queue) == 3);
+	return true;
+}
+
+// Random candidates checked against SPBPQueue, for every predefined capacity
+#define INLINE_BPQUEUE_RANDOM_TEST(N) \
+static bool inlineBPQueue##N##RandomTest() { \
+	SPInlineBPQueue##N queue; \
+	SPBPQueue expected = spBPQueueCreate(N); \
+	SPBPQueue converted; \
+	SPListElement element; \
+	unsigned int seed = 99 + N; \
+	int i; \
+	spInlineBPQueue##N##Init(&queue); \
+	for (i = 0; i < 300; i++) { \
+		seed = seed * 1103515245u + 12345u; \
+		element = spListElementCreate((int) ((seed >> 4) % 40), (double) ((seed >> 12) % 25)); \
+		ASSERT_TRUE(spInlineBPQueue##N##Enqueue(&queue, spListElementGetIndex(element), \
+				spListElementGetValue(element)) == spBPQueueEnqueue(expected, element)); \
+		spListElementDestroy(element); \
+		ASSERT_TRUE(spInlineBPQueue##N##MinValue(&queue) == spBPQueueMinValue(expected)); \
+		ASSERT_TRUE(spInlineBPQueue##N##MaxValue(&queue) == spBPQueueMaxValue(expected)); \
+	} \
+	converted = spInlineBPQueue##N##ToBPQueue(&queue); \
+	ASSERT_TRUE(spBPQueueSize(converted) == N && spBPQueueGetMaxSize(converted) == N); \
+	ASSERT_TRUE(spBPQueueMinValue(converted) == spBPQueueMinValue(expected)); \
+	spInlineBPQueue##N##Init(&queue); \
+	ASSERT_TRUE(spInlineBPQueue##N##FromBPQueue(&queue, converted)); \
+	ASSERT_TRUE(spInlineBPQueue##N##Size(&queue) == N); \
+	ASSERT_TRUE(spInlineBPQueue##N##MaxValue(&queue) == spBPQueueMaxValue(expected)); \
+	spBPQueueDestroy(converted); \
+	spBPQueueDestroy(expected); \
+	return true; \
+}
+
+INLINE_BPQUEUE_RANDOM_TEST(1)
+INLINE_BPQUEUE_RANDOM_TEST(4)
+INLINE_BPQUEUE_RANDOM_TEST(8)
+INLINE_BPQUEUE_RANDOM_TEST(16)
+
+static bool inlineBPQueueFromLargerBPQueueTest() {
+	SPInlineBPQueue1 queue;
+	SPBPQueue source = spBPQueueCreateWithBackend(3, SP_BPQUEUE_MINMAX_HEAP_BACKEND);
+	SPListElement e1 = spListElementCreate(1, 2.0);
+	SPListElement e2 = spListElementCreate(2, 1.0);
+	int index;
+	double value;
+	spBPQueueEnqueue(source, e1);
+	spBPQueueEnqueue(source, e2);
+	ASSERT_FALSE(spInlineBPQueue1FromBPQueue(&queue, NULL));
+	ASSERT_TRUE(spInlineBPQueue1FromBPQueue(&queue, source));
+	ASSERT_TRUE(spInlineBPQueue1Peek(&queue, &index, &value));
+	ASSERT_TRUE(index == 2 && value == 1.0 && spInlineBPQueue1IsFull(&queue));
+	spListElementDestroy(e1);
+	spListElementDestroy(e2);
+	spBPQueueDestroy(source);
+	return true;
+}
+
+// Random packed candidates checked against the unpacked queue of the same capacity
+#define INLINE_PACKED_BPQUEUE_RANDOM_TEST(N) \
+static bool inlinePackedBPQueue##N##RandomTest() { \
+	SPInlinePackedBPQueue##N packed; \
+	SPInlineBPQueue##N expected; \
+	SPPackedElement element; \
+	unsigned int seed = 7 + N; \
+	int i, index; \
+	double value; \
+	spInlinePackedBPQueue##N##Init(&packed); \
+	spInlineBPQueue##N##Init(&expected); \
+	ASSERT_FALSE(spInlinePackedBPQueue##N##Peek(&packed, &element)); \
+	ASSERT_TRUE(spInlinePackedBPQueue##N##MinValue(&packed) == -1); \
+	ASSERT_TRUE(spInlinePackedBPQueue##N##Enqueue(&packed, SP_PACKED_ELEMENT_MAX) == \
+			SP_BPQUEUE_INVALID_ARGUMENT); \
+	for (i = 0; i < 300; i++) { \
+		seed = seed * 1103515245u + 12345u; \
+		index = (int) ((seed >> 4) % 40); \
+		value = (double) ((seed >> 12) % 25) / 4.0;	/* Exact in float precision */ \
+		ASSERT_TRUE(spInlinePackedBPQueue##N##Enqueue(&packed, \
+				spPackedElementCreate(index, value)) == \
+				spInlineBPQueue##N##Enqueue(&expected, index, value)); \
+		ASSERT_TRUE(spInlinePackedBPQueue##N##Size(&packed) == spInlineBPQueue##N##Size(&expected)); \
+		ASSERT_TRUE(spInlinePackedBPQueue##N##MaxValue(&packed) == \
+				spInlineBPQueue##N##MaxValue(&expected)); \
+		if (i % 7 == 0) { \
+			ASSERT_TRUE(spInlinePackedBPQueue##N##Dequeue(&packed) == \
+					spInlineBPQueue##N##Dequeue(&expected)); \
+		} \
+	} \
+	ASSERT_TRUE(spInlinePackedBPQueue##N##IsFull(&packed)); \
+	while (spInlineBPQueue##N##Peek(&expected, &index, &value)) { \
+		ASSERT_TRUE(spInlinePackedBPQueue##N##Peek(&packed, &element)); \
+		ASSERT_TRUE(spPackedElementGetIndex(element) == index && \
+				spPackedElementGetValue(element) == value); \
+		spInlinePackedBPQueue##N##Dequeue(&packed); \
+		spInlineBPQueue##N##Dequeue(&expected); \
+	} \
+	ASSERT_TRUE(spInlinePackedBPQueue##N##IsEmpty(&packed)); \
+	ASSERT_TRUE(spInlinePackedBPQueue##N##Dequeue(&packed) == SP_BPQUEUE_EMPTY); \
+	return true; \
+}
+
+INLINE_PACKED_BPQUEUE_RANDOM_TEST(4)
+INLINE_PACKED_BPQUEUE_RANDOM_TEST(8)
+INLINE_PACKED_BPQUEUE_RANDOM_TEST(16)
+
+int main() {
+	RUN_TEST(inlineBPQueueEnqueueTest);
+	RUN_TEST(inlineBPQueue1RandomTest);
+	RUN_TEST(inlineBPQueue4RandomTest);
+	RUN_TEST(inlineBPQueue8RandomTest);
+	RUN_TEST(inlineBPQueue16RandomTest);
+	RUN_TEST(inlineBPQueueFromLargerBPQueueTest);
+	RUN_TEST(inlinePackedBPQueue4RandomTest);
+	RUN_TEST(inlinePackedBPQueue8RandomTest);
+	RUN_TEST(inlinePackedBPQueue16RandomTest);
+	return 0;
+}
@@ -0,0 +1,138 @@
+#include "../SPKeyedBPQueue.h"
+#include "../SPListElement.h"
+#include "unit_test_util.h"
+#include <stdbool.h>
+#include <limits.h>
+
+#define REFERENCE_RANGE 64
+
+static bool keyedBPQueueCreateTest() {
+	SPKeyedBPQueue queue = spKeyedBPQueueCreate(4);
+	ASSERT_TRUE(queue != NULL);
+	ASSERT_TRUE(spKeyedBPQueueCreate(0) == NULL);
+	ASSERT_TRUE(spKeyedBPQueueCreate(INT_MAX / 2 + 1) == NULL);
+	ASSERT_TRUE(spKeyedBPQueueCreate(INT_MAX) == NULL);
+	ASSERT_TRUE(spKeyedBPQueueGetMaxSize(queue) == 4);
+	ASSERT_TRUE(spKeyedBPQueueSize(queue) == 0);
+	ASSERT_TRUE(spKeyedBPQueueSize(NULL) == -1);
+	ASSERT_TRUE(spKeyedBPQueueIsEmpty(queue));
+	spKeyedBPQueueDestroy(queue);
+	return true;
+}
+
+static bool keyedBPQueueEnqueueTest() {
+	SPKeyedBPQueue queue = spKeyedBPQueueCreate(3);
+	SPListElement element;
+	ASSERT_TRUE(spKeyedBPQueueEnqueue(NULL, 1, 1.0) == SP_KEYED_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spKeyedBPQueueEnqueue(queue, -1, 1.0) == SP_KEYED_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spKeyedBPQueueEnqueue(queue, 1, 5.0) == SP_KEYED_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spKeyedBPQueueEnqueue(queue, 2, 4.0) == SP_KEYED_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spKeyedBPQueueEnqueue(queue, 1, 6.0) == SP_KEYED_BPQUEUE_NOT_IMPROVED);
+	ASSERT_TRUE(spKeyedBPQueueEnqueue(queue, 1, 3.0) == SP_KEYED_BPQUEUE_SUCCESS);	// Decrease
+	ASSERT_TRUE(spKeyedBPQueueSize(queue) == 2);
+	ASSERT_TRUE(spKeyedBPQueueGetValue(queue, 1) == 3.0);
+	ASSERT_TRUE(spKeyedBPQueueMaxValue(queue) == 4.0);
+	ASSERT_TRUE(spKeyedBPQueueEnqueue(queue, 3, 7.0) == SP_KEYED_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spKeyedBPQueueIsFull(queue));
+	ASSERT_TRUE(spKeyedBPQueueEnqueue(queue, 4, 8.0) == SP_KEYED_BPQUEUE_FULL);
+	ASSERT_TRUE(spKeyedBPQueueEnqueue(queue, 4, 1.0) == SP_KEYED_BPQUEUE_SUCCESS);	// Evicts 3
+	ASSERT_FALSE(spKeyedBPQueueContains(queue, 3));
+	ASSERT_TRUE(spKeyedBPQueueContains(queue, 4));
+	element = spKeyedBPQueuePeekLast(queue);
+	ASSERT_TRUE(spListElementGetIndex(element) == 2 && spListElementGetValue(element) == 4.0);
+	spListElementDestroy(element);
+	spKeyedBPQueueDestroy(queue);
+	return true;
+}
+
+static bool keyedBPQueueRemoveTest() {
+	SPKeyedBPQueue queue = spKeyedBPQueueCreate(8);
+	int i;
+	for (i = 0; i < 8; i++) {
+		spKeyedBPQueueEnqueue(queue, i * 10, (double) ((i * 5) % 8));
+	}
+	ASSERT_TRUE(spKeyedBPQueueRemove(NULL, 0) == SP_KEYED_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spKeyedBPQueueRemove(queue, 5) == SP_KEYED_BPQUEUE_NOT_FOUND);
+	ASSERT_TRUE(spKeyedBPQueueRemove(queue, 30) == SP_KEYED_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spKeyedBPQueueRemove(queue, 30) == SP_KEYED_BPQUEUE_NOT_FOUND);
+	ASSERT_TRUE(spKeyedBPQueueSize(queue) == 7);
+	for (i = 0; i < 8; i++) {
+		ASSERT_TRUE(spKeyedBPQueueContains(queue, i * 10) == (i != 3));
+	}
+	spKeyedBPQueueDestroy(queue);
+	return true;
+}
+
+// Indexes with a common power of two stride, which must not share home slots in the map
+static bool keyedBPQueueStridedTest() {
+	const int count = 4096, stride = 4096;
+	SPKeyedBPQueue queue = spKeyedBPQueueCreate(count);
+	int i;
+	for (i = 0; i < count; i++) {
+		ASSERT_TRUE(spKeyedBPQueueEnqueue(queue, i * stride, (double) (count - i)) ==
+				SP_KEYED_BPQUEUE_SUCCESS);
+	}
+	for (i = 0; i < count; i += 2) {
+		ASSERT_TRUE(spKeyedBPQueueRemove(queue, i * stride) == SP_KEYED_BPQUEUE_SUCCESS);
+	}
+	ASSERT_TRUE(spKeyedBPQueueSize(queue) == count / 2);
+	for (i = 0; i < count; i++) {
+		ASSERT_TRUE(spKeyedBPQueueContains(queue, i * stride) == (i % 2 == 1));
+		ASSERT_TRUE(spKeyedBPQueueGetValue(queue, i * stride) ==
+				(i % 2 == 1 ? (double) (count - i) : -1));
+	}
+	ASSERT_TRUE(spKeyedBPQueueMaxValue(queue) == (double) (count - 1));
+	spKeyedBPQueueDestroy(queue);
+	return true;
+}
+
+// Random updates and removals checked against a brute-force table of best values
+static bool keyedBPQueueRandomTest() {
+	SPKeyedBPQueue queue = spKeyedBPQueueCreate(REFERENCE_RANGE);
+	double best[REFERENCE_RANGE];
+	int indexes[REFERENCE_RANGE];
+	double values[REFERENCE_RANGE];
+	unsigned int seed = 12345;
+	int i, index, count = 0;
+	double value;
+	for (i = 0; i < REFERENCE_RANGE; i++) {
+		best[i] = -1;
+	}
+	for (i = 0; i < 20000; i++) {
+		seed = seed * 1103515245u + 12345u;
+		index = (int) ((seed >> 16) % REFERENCE_RANGE);
+		value = (double) ((seed >> 4) % 1000);
+		if (i % 5 == 0) {
+			ASSERT_TRUE((spKeyedBPQueueRemove(queue, index) == SP_KEYED_BPQUEUE_SUCCESS) ==
+					(best[index] >= 0));
+			best[index] = -1;
+		} else {
+			spKeyedBPQueueEnqueue(queue, index, value);
+			if (best[index] < 0 || value < best[index]) {
+				best[index] = value;
+			}
+		}
+	}
+	for (i = 0; i < REFERENCE_RANGE; i++) {
+		ASSERT_TRUE(spKeyedBPQueueGetValue(queue, i) == best[i]);
+		count += best[i] >= 0;
+	}
+	ASSERT_TRUE(spKeyedBPQueueSize(queue) == count);
+	ASSERT_TRUE(spKeyedBPQueueDrainSorted(queue, indexes, values) == SP_KEYED_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spKeyedBPQueueIsEmpty(queue));
+	for (i = 1; i < count; i++) {
+		ASSERT_TRUE(values[i - 1] < values[i] ||
+				(values[i - 1] == values[i] && indexes[i - 1] < indexes[i]));
+	}
+	spKeyedBPQueueDestroy(queue);
+	return true;
+}
+
+int main() {
+	RUN_TEST(keyedBPQueueCreateTest);
+	RUN_TEST(keyedBPQueueEnqueueTest);
+	RUN_TEST(keyedBPQueueRemoveTest);
+	RUN_TEST(keyedBPQueueStridedTest);
+	RUN_TEST(keyedBPQueueRandomTest);
+	return 0;
+}
@@ -418,6 +418,270 @@ static bool testListForEach() {
 	spListElementDestroy(e5);
 	return true;
 }
+static bool testListPool() {
+	SPListNodePool pool = spListNodePoolCreate(2);
+	SPList list = spListCreateWithPool(pool);
+	SPList owned = spListCreateWithPool(NULL);
+	SPList copy;
+	SPListElement e = spListElementCreate(1, 1.0);
+	ASSERT_TRUE(spListNodePoolCreate(0) == NULL);
+	ASSERT_TRUE(list != NULL && owned != NULL);
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < 5; i++) {
+			spListElementSetIndex(e, i);
+			ASSERT_TRUE(spListInsertLast(list, e) == SP_LIST_SUCCESS);
+			ASSERT_TRUE(spListInsertFirst(owned, e) == SP_LIST_SUCCESS);
+		}
+		ASSERT_TRUE(spListGetSize(list) == 5);
+		spListGetFirst(list);
+		ASSERT_TRUE(spListRemoveCurrent(list) == SP_LIST_SUCCESS);
+		ASSERT_TRUE(spListElementGetIndex(spListGetFirst(list)) == 1);
+		ASSERT_TRUE(spListElementGetIndex(spListGetLast(owned)) == 0);
+		ASSERT_TRUE(spListClear(list) == SP_LIST_SUCCESS);
+		ASSERT_TRUE(spListGetSize(list) == 0 && spListGetFirst(list) == NULL);
+	}
+	ASSERT_TRUE(spListGetSize(owned) == 15);
+	copy = spListCopy(owned);
+	ASSERT_TRUE(copy != NULL && spListGetSize(copy) == 15);
+	spListDestroy(owned);
+	ASSERT_TRUE(spListElementGetIndex(spListGetFirst(copy)) == 4);
+	spListDestroy(copy);
+	spListDestroy(list);
+	spListNodePoolDestroy(pool);
+	spListElementDestroy(e);
+	return true;
+}
+static bool testListElementStorage() {
+	SPListElement e1 = spListElementCreate(1, 1.0);
+	SPListElement e2 = spListElementCreate(2, 2.0);
+	SPList list = quickList(1, e1);
+	SPListElement stored = spListGetFirst(list);
+	ASSERT_TRUE(stored != e1);//The list holds its own copy
+	spListElementSetValue(e1, 5.0);
+	ASSERT_TRUE(spListElementGetValue(stored) == 1.0);
+	for (int i = 0; i < 100; i++) {
+		ASSERT_TRUE(spListInsertFirst(list, e2) == SP_LIST_SUCCESS);
+		ASSERT_TRUE(spListInsertLast(list, e2) == SP_LIST_SUCCESS);
+	}
+	ASSERT_TRUE(spListGetSize(list) == 201);
+	//The stored element did not move while others were inserted
+	ASSERT_TRUE(spListElementGetIndex(stored) == 1 && spListElementGetValue(stored) == 1.0);
+	spListDestroy(list);
+	spListElementDestroy(e1);
+	spListElementDestroy(e2);
+	return true;
+}
+static bool testListElementValue() {
+	SPListElementValue v = spListElementValueCreate(3, 1.5);
+	ASSERT_TRUE(spListElementValueGetIndex(v) == 3 && spListElementValueGetValue(v) == 1.5);
+	spListElementValueSetIndex(&v, 4);
+	spListElementValueSetValue(&v, 2.5);
+	ASSERT_TRUE(v.index == 4 && v.value == 2.5);
+	ASSERT_TRUE(spListElementValueCompare(v, spListElementValueCreate(4, 2.5)) == 0);
+	ASSERT_TRUE(spListElementValueCompare(v, spListElementValueCreate(9, 2.0)) == 1);
+	ASSERT_TRUE(spListElementValueCompare(v, spListElementValueCreate(5, 2.5)) == -1);
+	ASSERT_TRUE(spListElementValueIsLess(spListElementValueCreate(1, 2.5), v));
+	ASSERT_FALSE(spListElementValueIsLess(v, v));
+	SPListElement e1 = spListElementCreateFromValue(v);
+	SPListElement e2 = spListElementCreate(100, 0.5);
+	ASSERT_TRUE(spListElementGetIndex(e1) == 4 && spListElementGetValue(e1) == 2.5);
+	ASSERT_TRUE(spListElementCompare(e1, e2) == 1 && spListElementCompare(e2, e1) == -1);
+	ASSERT_TRUE(spListElementValueCompare(spListElementToValue(e1), v) == 0);
+
+	SPList list = spListCreate();
+	ASSERT_TRUE(spListInsertLastValue(NULL, v) == SP_LIST_NULL_ARGUMENT);
+	ASSERT_TRUE(spListInsertBeforeCurrentValue(list, v) == SP_LIST_INVALID_CURRENT);
+	ASSERT_TRUE(spListInsertFirstValue(list, spListElementValueCreate(-1, 1.0)) ==
+			SP_LIST_INVALID_ARGUMENT);
+	ASSERT_TRUE(spListInsertLastValue(list, spListElementValueCreate(1, -1.0)) ==
+			SP_LIST_INVALID_ARGUMENT);
+	ASSERT_TRUE(spListGetSize(list) == 0);
+	ASSERT_TRUE(spListInsertLastValue(list, spListElementValueCreate(2, 2.0)) == SP_LIST_SUCCESS);
+	ASSERT_TRUE(spListInsertFirstValue(list, spListElementValueCreate(0, 0.0)) == SP_LIST_SUCCESS);
+	spListGetFirst(list);
+	ASSERT_TRUE(spListInsertAfterCurrentValue(list, spListElementValueCreate(1, 1.0)) == SP_LIST_SUCCESS);
+	spListGetLast(list);
+	ASSERT_TRUE(spListInsertBeforeCurrentValue(list, spListElementValueCreate(5, 1.5)) == SP_LIST_SUCCESS);
+	int expected[] = { 0, 1, 5, 2 };
+	int i = 0;
+	SP_LIST_ITERATOR_FOREACH(it, list) {
+		ASSERT_TRUE(spListElementValueGetIndex(spListIteratorGetValue(it)) == expected[i++]);
+	}
+	ASSERT_TRUE(i == 4);
+	ASSERT_TRUE(spListInsertAfterCurrentValue(list, spListElementValueCreate(-1, 1.0)) ==
+			SP_LIST_INVALID_ARGUMENT);
+	ASSERT_TRUE(spListInsertBeforeCurrentValue(list, spListElementValueCreate(1, -1.0)) ==
+			SP_LIST_INVALID_ARGUMENT);
+	ASSERT_TRUE(spListGetSize(list) == 4);
+	spListDestroy(list);
+	spListElementDestroy(e1);
+	spListElementDestroy(e2);
+	return true;
+}
+static bool testListAppendArray() {
+	int indexes[100];
+	double values[100];
+	SPList list = spListCreate();
+	SPList pooled = spListCreateWithPool(NULL);
+	for (int i = 0; i < 100; i++) {
+		indexes[i] = i;
+		values[i] = 100.0 - i;
+	}
+	ASSERT_TRUE(spListAppendArray(NULL, indexes, values, 1) == SP_LIST_NULL_ARGUMENT);
+	ASSERT_TRUE(spListAppendArray(list, NULL, values, 1) == SP_LIST_NULL_ARGUMENT);
+	ASSERT_TRUE(spListAppendArray(list, NULL, NULL, 0) == SP_LIST_SUCCESS);
+	values[1] = -1.0;
+	ASSERT_TRUE(spListAppendArray(list, indexes, values, 2) == SP_LIST_INVALID_ARGUMENT);
+	values[1] = 99.0;
+	indexes[1] = -1;
+	ASSERT_TRUE(spListAppendArray(list, indexes, values, 2) == SP_LIST_INVALID_ARGUMENT);
+	indexes[1] = 1;
+	ASSERT_TRUE(spListGetSize(list) == 0);
+	ASSERT_TRUE(spListAppendArray(list, indexes, values, 50) == SP_LIST_SUCCESS);
+	ASSERT_TRUE(spListAppendArray(list, indexes + 50, values + 50, 50) == SP_LIST_SUCCESS);
+	ASSERT_TRUE(spListAppendArray(pooled, indexes, values, 30) == SP_LIST_SUCCESS);
+	ASSERT_TRUE(spListClear(pooled) == SP_LIST_SUCCESS);	//Reuses the freed nodes
+	ASSERT_TRUE(spListAppendArray(pooled, indexes, values, 100) == SP_LIST_SUCCESS);
+	ASSERT_TRUE(spListGetSize(list) == 100 && spListGetSize(pooled) == 100);
+	int i = 0;
+	SP_LIST_FOREACH(SPListElement, e, list) {
+		ASSERT_TRUE(spListElementGetIndex(e) == i && spListElementGetValue(e) == 100.0 - i);
+		i++;
+	}
+	i = 99;
+	for (SPListElement e = spListGetLast(pooled); e; e = spListGetPrevious(pooled)) {
+		ASSERT_TRUE(spListElementGetIndex(e) == i);
+		i--;
+	}
+	ASSERT_TRUE(i == -1);
+	spListDestroy(list);
+	spListDestroy(pooled);
+	return true;
+}
+static bool testListConcat() {
+	int indexes[6] = {0, 1, 2, 3, 4, 5};
+	double values[6] = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0};
+	SPListNodePool pool = spListNodePoolCreate(4);
+	SPList list = spListCreateWithPool(pool);
+	SPList other = spListCreateWithPool(pool);
+	SPList foreign = spListCreate();
+	spListAppendArray(list, indexes, values, 2);
+	spListAppendArray(other, indexes + 4, values + 4, 2);
+	spListAppendArray(foreign, indexes + 2, values + 2, 2);
+	ASSERT_TRUE(spListConcat(NULL, other) == SP_LIST_NULL_ARGUMENT);
+	ASSERT_TRUE(spListConcat(list, other) == SP_LIST_SUCCESS);	//Moves the nodes
+	ASSERT_TRUE(spListGetSize(other) == 0 && spListGetFirst(other) == NULL);
+	ASSERT_TRUE(spListConcat(list, list) == SP_LIST_SUCCESS);
+	spListGetFirst(list);
+	spListGetNext(list);
+	ASSERT_TRUE(spListSplice(list, foreign) == SP_LIST_SUCCESS);	//Copies the elements
+	ASSERT_TRUE(spListGetSize(foreign) == 0);
+	ASSERT_TRUE(spListGetSize(list) == 6);
+	int i = 0;
+	SP_LIST_FOREACH(SPListElement, e, list) {
+		ASSERT_TRUE(spListElementGetIndex(e) == i);
+		i++;
+	}
+	ASSERT_TRUE(spListSplice(list, other) == SP_LIST_INVALID_CURRENT);
+	spListAppendArray(other, indexes, values, 6);
+	spListDestroy(list);	//Other still uses the shared pool
+	ASSERT_TRUE(spListGetSize(other) == 6);
+	spListDestroy(other);
+	spListDestroy(foreign);
+	spListNodePoolDestroy(pool);
+	return true;
+}
+static bool testListIterator() {
+	int indexes[4] = {0, 1, 2, 3};
+	double values[4] = {0.0, 1.0, 2.0, 3.0};
+	SPList list = spListCreate();
+	SPList copy;
+	SPListIterator it = spListIteratorFirst(list);
+	ASSERT_FALSE(spListIteratorIsValid(it));
+	ASSERT_TRUE(spListIteratorGet(it) == NULL);
+	ASSERT_TRUE(spListPeekFirst(list) == NULL);
+	spListAppendArray(list, indexes, values, 4);
+	spListGetFirst(list);
+	spListGetNext(list);
+	SPListElement current = spListGetCurrent(list);
+	int pairs = 0;
+	SP_LIST_ITERATOR_FOREACH(outer, list) {	//Nested loops over one list
+		SP_LIST_ITERATOR_FOREACH(inner, list) {
+			if (spListElementCompare(spListIteratorGet(outer), spListIteratorGet(inner)) < 0) {
+				pairs++;
+			}
+		}
+	}
+	ASSERT_TRUE(pairs == 6);
+	ASSERT_TRUE(spListElementGetIndex(spListPeekFirst(list)) == 0);
+	ASSERT_TRUE(spListElementGetIndex(spListPeekLast(list)) == 3);
+	copy = spListCopy(list);
+	ASSERT_TRUE(spListGetCurrent(list) == current);	//Internal iterator is untouched
+	it = spListIteratorLast(copy);
+	for (int i = 3; i >= 0; i--) {
+		ASSERT_TRUE(spListElementGetIndex(spListIteratorGet(it)) == i);
+		it = spListIteratorPrevious(it);
+	}
+	ASSERT_FALSE(spListIteratorIsValid(it));
+	spListDestroy(copy);
+	spListDestroy(list);
+	return true;
+}
+static bool isSortedList(SPList list, int size) {
+	SPListElement previous = NULL;
+	int count = 0;
+	SP_LIST_FOREACH(SPListElement, e, list) {
+		if (previous && spListElementCompare(previous, e) > 0) {
+			return false;
+		}
+		previous = e;
+		count++;
+	}
+	//The backward links must agree with the order
+	SPListIterator it = spListIteratorLast(list);
+	for (int i = 0; i < count; i++) {
+		it = spListIteratorPrevious(it);
+	}
+	return count == size && count == spListGetSize(list) && !spListIteratorIsValid(it);
+}
+static bool testListSort() {
+	int indexes[1000];
+	double values[1000];
+	unsigned int seed = 7;
+	for (int i = 0; i < 1000; i++) {
+		seed = seed * 1103515245u + 12345u;
+		indexes[i] = i;
+		values[i] = (double) ((seed >> 16) % 50);
+	}
+	ASSERT_TRUE(spListSort(NULL) == SP_LIST_NULL_ARGUMENT);
+	ASSERT_TRUE(spListCreateSorted(NULL, values, 3) == NULL);
+	SPList list = spListCreateSorted(indexes, values, 1000);
+	ASSERT_TRUE(isSortedList(list, 1000));
+	ASSERT_TRUE(spListSort(list) == SP_LIST_SUCCESS);	//Already sorted
+	ASSERT_TRUE(isSortedList(list, 1000));
+	spListGetFirst(list);
+	ASSERT_TRUE(spListRemoveCurrent(list) == SP_LIST_SUCCESS);	//The pooled node is reused
+	ASSERT_TRUE(spListInsertFirstValue(list, spListElementValueCreate(indexes[0], 0.0)) ==
+			SP_LIST_SUCCESS);
+	ASSERT_TRUE(isSortedList(list, 1000));
+	spListDestroy(list);
+	indexes[1] = -1;
+	ASSERT_TRUE(spListCreateSorted(indexes, values, 3) == NULL);
+	indexes[1] = 1;
+	list = spListCreate();
+	for (int i = 0; i < 100; i++) {		//Descending input
+		spListAppendArray(list, indexes + i, values + i, 1);
+		spListElementSetValue(spListPeekLast(list), 100.0 - i);
+	}
+	ASSERT_TRUE(spListSort(list) == SP_LIST_SUCCESS);
+	ASSERT_TRUE(isSortedList(list, 100));
+	ASSERT_TRUE(spListElementGetIndex(spListPeekFirst(list)) == 99);
+	spListDestroy(list);
+	list = spListCreateSorted(indexes, values, 0);
+	ASSERT_TRUE(list != NULL && spListSort(list) == SP_LIST_SUCCESS && isSortedList(list, 0));
+	spListDestroy(list);
+	return true;
+}
 int main() {
 	RUN_TEST(testElementCreate);
 	RUN_TEST(testElementCopy);
@@ -440,5 +704,12 @@ int main() {
 	RUN_TEST(testListClear);
 	RUN_TEST(testListDestroy);
 	RUN_TEST(testListForEach);
+	RUN_TEST(testListPool);
+	RUN_TEST(testListElementStorage);
+	RUN_TEST(testListAppendArray);
+	RUN_TEST(testListConcat);
+	RUN_TEST(testListIterator);
+	RUN_TEST(testListSort);
+	RUN_TEST(testListElementValue);
 	return 0;
 }
@@ -128,6 +128,650 @@ static bool basicLoggerDestroyUndefinedTest() {
 	ASSERT_TRUE(spLoggerPrintError("MSGC","sp_logger_unit_test.c",__func__,__LINE__) == SP_LOGGER_UNDIFINED); // null logger
 	return true;
 }
+// The tests above log their own line numbers, so new includes go below them
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#define ASYNC_THREADS 4
+#define ASYNC_RECORDS 2000
+
+static void* asyncProducer(void* args) {
+	(void) args;
+	for (int i = 0; i < ASYNC_RECORDS; i++) {
+		spLoggerPrintWarning("MSGB", "sp_logger_unit_test.c", __func__, __LINE__);
+	}
+	return NULL;
+}
+
+// Counts the records of the producers, and sums the dropped record reports
+static bool countRecords(const char* fname, int* records, unsigned long* reported) {
+	char line[128];
+	unsigned long dropped;
+	FILE* fp = fopen(fname, "r");
+	if (fp == NULL) {
+		return false;
+	}
+	*records = 0;
+	*reported = 0;
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		if (strcmp(line, "---WARNING---\n") == 0) {
+			(*records)++;
+		} else if (sscanf(line, "- message: %lu log records were dropped", &dropped) == 1) {
+			*reported += dropped;
+		}
+	}
+	fclose(fp);
+	return true;
+}
+
+// Writes records from several threads, returns the number of dropped records
+static unsigned long runAsyncProducers() {
+	pthread_t threads[ASYNC_THREADS];
+	for (int i = 0; i < ASYNC_THREADS; i++) {
+		pthread_create(&threads[i], NULL, asyncProducer, NULL);
+	}
+	for (int i = 0; i < ASYNC_THREADS; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	return spLoggerGetDroppedCount();
+}
+
+//An asynchronous logger writes the same records as a synchronous one
+static bool asyncLoggerLevelTest() {
+	const char* expectedFile = "basicLoggerDebugTestExp.log";
+	const char* testFile = "asyncLoggerDebugTest.log";
+	ASSERT_TRUE(spLoggerCreateAsync(testFile,SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL,0,SP_LOGGER_OVERFLOW_BLOCK) == SP_LOGGER_INVAlID_ARGUMENT);
+	ASSERT_TRUE(spLoggerCreateAsync(testFile,SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL,4,SP_LOGGER_OVERFLOW_BLOCK) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerCreateAsync(testFile,SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL,4,SP_LOGGER_OVERFLOW_BLOCK) == SP_LOGGER_DEFINED);
+	ASSERT_TRUE(spLoggerPrintError("MSGA","sp_logger_unit_test.c","basicLoggerDebugTest",64) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintWarning("MSGB","sp_logger_unit_test.c","basicLoggerDebugTest",65) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintInfo("MSGC") == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintDebug("MSGD","sp_logger_unit_test.c","basicLoggerDebugTest",67) == SP_LOGGER_SUCCESS);
+	spLoggerDestroy();
+	ASSERT_TRUE(identicalFiles(testFile,expectedFile));
+	return true;
+}
+
+//Blocking producers lose no records
+static bool asyncLoggerBlockTest() {
+	const char* testFile = "asyncLoggerBlockTest.log";
+	int records;
+	unsigned long reported;
+	ASSERT_TRUE(spLoggerCreateAsync(testFile,SP_LOGGER_WARNING_ERROR_LEVEL,8,SP_LOGGER_OVERFLOW_BLOCK) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(runAsyncProducers() == 0);
+	spLoggerDestroy();
+	ASSERT_TRUE(countRecords(testFile, &records, &reported));
+	ASSERT_TRUE(records == ASYNC_THREADS * ASYNC_RECORDS && reported == 0);
+	return true;
+}
+
+//Every record is either written or dropped, and dropped records are reported
+static bool asyncLoggerDropTest() {
+	const char* testFile = "asyncLoggerDropTest.log";
+	SP_LOGGER_OVERFLOW_POLICY policies[] = { SP_LOGGER_OVERFLOW_DROP, SP_LOGGER_OVERFLOW_COUNT };
+	int records;
+	unsigned long reported;
+	for (int i = 0; i < 2; i++) {
+		ASSERT_TRUE(spLoggerCreateAsync(testFile,SP_LOGGER_WARNING_ERROR_LEVEL,2,policies[i]) == SP_LOGGER_SUCCESS);
+		unsigned long dropped = runAsyncProducers();
+		spLoggerDestroy();
+		ASSERT_TRUE(spLoggerGetDroppedCount() == 0);
+		ASSERT_TRUE(countRecords(testFile, &records, &reported));
+		ASSERT_TRUE(records + dropped == ASYNC_THREADS * ASYNC_RECORDS);
+		ASSERT_TRUE(reported == (policies[i] == SP_LOGGER_OVERFLOW_COUNT ? dropped : 0));
+	}
+	return true;
+}
+#define RACE_ROUNDS 50
+
+typedef struct record_args_t {
+	int thread;
+	bool stop;
+} RecordArgs;
+
+// Logs records whose fields all identify the thread and the record
+static void* recordProducer(void* args) {
+	RecordArgs* recordArgs = (RecordArgs*) args;
+	char function[32];
+	char msg[32];
+	sprintf(function, "thread%d", recordArgs->thread);
+	for (int i = 0; i < ASYNC_RECORDS; i++) {
+		sprintf(msg, "thread%d", recordArgs->thread);
+		spLoggerPrintWarning(msg, "sp_logger_unit_test.c", function, i);
+	}
+	return NULL;
+}
+
+//Records of concurrent threads are written whole
+static bool concurrentLoggerRecordsTest() {
+	const char* testFile = "concurrentLoggerRecordsTest.log";
+	pthread_t threads[ASYNC_THREADS];
+	RecordArgs args[ASYNC_THREADS];
+	int next[ASYNC_THREADS] = { 0 };
+	char lines[5][64];
+	int thread, line, records = 0;
+	ASSERT_TRUE(spLoggerCreate(testFile,SP_LOGGER_WARNING_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	for (int i = 0; i < ASYNC_THREADS; i++) {
+		args[i].thread = i;
+		pthread_create(&threads[i], NULL, recordProducer, &args[i]);
+	}
+	for (int i = 0; i < ASYNC_THREADS; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	spLoggerDestroy();
+	FILE* fp = fopen(testFile, "r");
+	ASSERT_TRUE(fp != NULL);
+	while (fgets(lines[0], sizeof(lines[0]), fp) != NULL) {
+		for (int i = 1; i < 5; i++) {
+			ASSERT_TRUE(fgets(lines[i], sizeof(lines[i]), fp) != NULL);
+		}
+		ASSERT_TRUE(strcmp(lines[0], "---WARNING---\n") == 0);
+		ASSERT_TRUE(strcmp(lines[1], "- file: sp_logger_unit_test.c\n") == 0);
+		ASSERT_TRUE(sscanf(lines[2], "- function: thread%d", &thread) == 1);
+		ASSERT_TRUE(thread >= 0 && thread < ASYNC_THREADS);
+		ASSERT_TRUE(sscanf(lines[3], "- line: %d", &line) == 1 && line == next[thread]++);
+		ASSERT_TRUE(sscanf(lines[4], "- message: thread%d", &line) == 1 && line == thread);
+		records++;
+	}
+	fclose(fp);
+	ASSERT_TRUE(records == ASYNC_THREADS * ASYNC_RECORDS);
+	return true;
+}
+
+static void* racingProducer(void* args) {
+	RecordArgs* recordArgs = (RecordArgs*) args;
+	while (!__atomic_load_n(&recordArgs->stop, __ATOMIC_ACQUIRE)) {
+		SP_LOGGER_MSG result = spLoggerPrintMsg("MSG");
+		if (result != SP_LOGGER_SUCCESS && result != SP_LOGGER_UNDIFINED) {
+			recordArgs->thread = -1;
+		}
+	}
+	return NULL;
+}
+
+//Loggers may be created and destroyed while other threads print
+static bool concurrentLoggerCreateDestroyTest() {
+	const char* testFile = "concurrentLoggerCreateDestroyTest.log";
+	pthread_t threads[ASYNC_THREADS];
+	RecordArgs args[ASYNC_THREADS];
+	for (int i = 0; i < ASYNC_THREADS; i++) {
+		args[i].thread = i;
+		args[i].stop = false;
+		pthread_create(&threads[i], NULL, racingProducer, &args[i]);
+	}
+	for (int i = 0; i < RACE_ROUNDS; i++) {
+		if (i % 2 == 0) {
+			ASSERT_TRUE(spLoggerCreate(testFile,SP_LOGGER_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+		} else {
+			ASSERT_TRUE(spLoggerCreateAsync(testFile,SP_LOGGER_ERROR_LEVEL,4,SP_LOGGER_OVERFLOW_BLOCK) == SP_LOGGER_SUCCESS);
+		}
+		spLoggerDestroy();
+	}
+	for (int i = 0; i < ASYNC_THREADS; i++) {
+		__atomic_store_n(&args[i].stop, true, __ATOMIC_RELEASE);
+		pthread_join(threads[i], NULL);
+		ASSERT_TRUE(args[i].thread == i);
+	}
+	return true;
+}
+static int evaluatedMessages = 0;
+
+static const char* countedMessage(const char* msg) {
+	evaluatedMessages++;
+	return msg;
+}
+
+//The macros print the call site, and skip filtered records without evaluating them
+static bool loggerMacrosTest() {
+	const char* testFile = "loggerMacrosTest.log";
+	char line[128];
+	int lineNumber = 0;
+	evaluatedMessages = 0;
+	SP_LOG_ERROR(countedMessage("MSGA"));	// Undefined logger
+	ASSERT_TRUE(evaluatedMessages == 0 && !SP_LOGGER_IS_ENABLED(SP_LOGGER_ERROR_LEVEL));
+	ASSERT_TRUE(spLoggerCreate(testFile,SP_LOGGER_WARNING_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(SP_LOGGER_IS_ENABLED(SP_LOGGER_WARNING_ERROR_LEVEL));
+	ASSERT_FALSE(SP_LOGGER_IS_ENABLED(SP_LOGGER_INFO_WARNING_ERROR_LEVEL));
+	SP_LOG_DEBUG(countedMessage("MSGD"));
+	SP_LOG_INFO(countedMessage("MSGC"));
+	ASSERT_TRUE(evaluatedMessages == 0);
+	SP_LOG_WARNING(countedMessage("MSGB")); lineNumber = __LINE__;
+	SP_LOG_MSG(countedMessage("MSG"));
+	ASSERT_TRUE(evaluatedMessages == 2);
+	spLoggerDestroy();
+	ASSERT_FALSE(SP_LOGGER_IS_ENABLED(SP_LOGGER_ERROR_LEVEL));
+
+	FILE* fp = fopen(testFile, "r");
+	ASSERT_TRUE(fp != NULL);
+	char expectedFile[128];
+	char expectedLine[64];
+	sprintf(expectedFile, "- file: %s\n", __FILE__);
+	sprintf(expectedLine, "- line: %d\n", lineNumber);
+	const char* expected[] = { "---WARNING---\n", expectedFile,
+			"- function: loggerMacrosTest\n", expectedLine, "- message: MSGB\n",
+			"- message: MSG\n" };
+	for (int i = 0; i < 6; i++) {
+		ASSERT_TRUE(fgets(line, sizeof(line), fp) != NULL);
+		ASSERT_TRUE(strcmp(line, expected[i]) == 0);
+	}
+	ASSERT_TRUE(fgets(line, sizeof(line), fp) == NULL);
+	fclose(fp);
+	return true;
+}
+//Reads the messages of a log into messages, returns their number
+static int readMessages(const char* filename, char messages[][64], int max) {
+	char line[128];
+	int count = 0;
+	FILE* fp = fopen(filename, "r");
+	if (fp == NULL) {
+		return -1;
+	}
+	while (count < max && fgets(line, sizeof(line), fp) != NULL) {
+		if (strncmp(line, "- message: ", 11) == 0) {
+			strcpy(messages[count++], line + 11);
+		}
+	}
+	fclose(fp);
+	return count;
+}
+
+//Prints the same records through every print function and macro
+static void printBinaryTestRecords() {
+	char longMsg[1024];
+	memset(longMsg, 'x', sizeof(longMsg) - 1);
+	longMsg[sizeof(longMsg) - 1] = '\0';
+	spLoggerPrintError("MSGA", "sp_logger_unit_test.c", __func__, __LINE__);
+	spLoggerPrintWarning("MSGB", "sp_logger_unit_test.c", __func__, __LINE__);
+	spLoggerPrintInfo("MSGC");
+	spLoggerPrintDebug("MSGD", "sp_logger_unit_test.c", __func__, __LINE__);
+	spLoggerPrintMsg("MSGE");
+	for (int i = 0; i < 3; i++) {
+		SP_LOG_ERROR("MSGA");
+		SP_LOG_WARNING("MSGB");
+		SP_LOG_INFO("MSGC");
+		SP_LOG_DEBUG(i == 1 ? longMsg : "MSGD");
+		SP_LOG_MSG("MSGE");
+	}
+}
+
+static bool filesEqual(const char* first, const char* second) {
+	FILE* fp1 = fopen(first, "r");
+	FILE* fp2 = fopen(second, "r");
+	bool equal = fp1 != NULL && fp2 != NULL;
+	int c1 = 0, c2 = 0;
+	while (equal && c1 != EOF) {
+		c1 = fgetc(fp1);
+		c2 = fgetc(fp2);
+		equal = c1 == c2;
+	}
+	if (fp1 != NULL) {
+		fclose(fp1);
+	}
+	if (fp2 != NULL) {
+		fclose(fp2);
+	}
+	return equal;
+}
+
+//A decoded binary log equals the log of a text logger, also for a second binary logger
+static bool binaryLoggerDecodeTest() {
+	const char* textFile = "binaryLoggerTextTest.log";
+	const char* binaryFile = "binaryLoggerTest.bin";
+	const char* decodedFile = "binaryLoggerDecodedTest.log";
+	SP_LOGGER_LEVEL levels[] = { SP_LOGGER_DEBUG_INFO_WARNING_ERROR_LEVEL,
+			SP_LOGGER_WARNING_ERROR_LEVEL };
+	for (int i = 0; i < 2; i++) {
+		ASSERT_TRUE(spLoggerCreate(textFile, levels[i]) == SP_LOGGER_SUCCESS);
+		printBinaryTestRecords();
+		spLoggerDestroy();
+		ASSERT_TRUE(spLoggerCreateBinary(binaryFile, levels[i]) == SP_LOGGER_SUCCESS);
+		ASSERT_TRUE(spLoggerCreateBinary(binaryFile, levels[i]) == SP_LOGGER_DEFINED);
+		printBinaryTestRecords();
+		spLoggerDestroy();
+		ASSERT_TRUE(spLoggerDecode(binaryFile, decodedFile) == SP_LOGGER_SUCCESS);
+		ASSERT_TRUE(filesEqual(textFile, decodedFile));
+	}
+	return true;
+}
+
+//A log whose last record is incomplete is decoded up to that record
+static bool binaryLoggerTruncatedTest() {
+	const char* binaryFile = "binaryLoggerTruncatedTest.bin";
+	const char* decodedFile = "binaryLoggerTruncatedTest.log";
+	char buffer[256];
+	char messages[16][64];
+	ASSERT_TRUE(spLoggerCreateBinary(binaryFile, SP_LOGGER_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	SP_LOG_MSG("MSGA");
+	SP_LOG_MSG("MSGB");
+	spLoggerPrintMsg("MSGC");
+	spLoggerDestroy();
+	FILE* fp = fopen(binaryFile, "rb");
+	ASSERT_TRUE(fp != NULL);
+	size_t size = fread(buffer, 1, sizeof(buffer), fp);
+	fclose(fp);
+	for (size_t cut = 1; cut <= 3; cut++) { // Cut in the message, its length and the tag
+		size_t lengths[] = { 0, 3, 4 + 4 + 4, 4 + 4 + 4 + 4 + 8 + 4 + 4 + 1 + 1 };
+		fp = fopen(binaryFile, "wb");
+		ASSERT_TRUE(fp != NULL);
+		ASSERT_TRUE(fwrite(buffer, 1, size - lengths[cut], fp) == size - lengths[cut]);
+		fclose(fp);
+		ASSERT_TRUE(spLoggerDecode(binaryFile, decodedFile) == SP_LOGGER_SUCCESS);
+		ASSERT_TRUE(readMessages(decodedFile, messages, 16) == 2);
+		ASSERT_TRUE(strcmp(messages[0], "MSGA\n") == 0 && strcmp(messages[1], "MSGB\n") == 0);
+	}
+	return true;
+}
+
+//An event of a site that was never described is decoded as an error of an unknown site
+static bool binaryLoggerUnknownSiteTest() {
+	const char* binaryFile = "binaryLoggerUnknownSite.bin";
+	const char* decodedFile = "binaryLoggerUnknownSite.log";
+	const char log[] = "SPLOGB1\n"
+			"S\x01\x00\x00\x00\x04\x01\x00\x00\x00"
+			"\x04\x00\x00\x00" "file" "\x04\x00\x00\x00" "func"
+			"E\x07\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x04\x00\x00\x00" "MSG1"
+			"E\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x04\x00\x00\x00" "MSG2";
+	const char expected[] = "---ERROR---\n- file: (unknown site 7)\n- function: (unknown)\n"
+			"- line: 0\n- message: MSG1\n- message: MSG2\n";
+	char decoded[sizeof(expected) + 1];
+	FILE* fp = fopen(binaryFile, "wb");
+	ASSERT_TRUE(fp != NULL);
+	ASSERT_TRUE(fwrite(log, 1, sizeof(log) - 1, fp) == sizeof(log) - 1);
+	fclose(fp);
+	ASSERT_TRUE(spLoggerDecode(binaryFile, decodedFile) == SP_LOGGER_SUCCESS);
+	fp = fopen(decodedFile, "r");
+	ASSERT_TRUE(fp != NULL);
+	size_t size = fread(decoded, 1, sizeof(decoded), fp);
+	fclose(fp);
+	ASSERT_TRUE(size == sizeof(expected) - 1 && memcmp(decoded, expected, size) == 0);
+	return true;
+}
+
+//Invalid sites and files are reported
+static bool binaryLoggerArgumentTest() {
+	SPLoggerSite site = { SP_LOGGER_WARNING_RECORD, "file", NULL, 1, 0, 0, 0, 0 };
+	ASSERT_TRUE(spLoggerDecode(NULL, NULL) == SP_LOGGER_INVAlID_ARGUMENT);
+	ASSERT_TRUE(spLoggerDecode("binaryLoggerMissing.bin", NULL) == SP_LOGGER_CANNOT_OPEN_FILE);
+	ASSERT_TRUE(spLoggerCreate("binaryLoggerNotBinary.log", SP_LOGGER_ERROR_LEVEL) ==
+			SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintSite(&site, "MSG") == SP_LOGGER_INVAlID_ARGUMENT);
+	ASSERT_TRUE(spLoggerPrintSite(NULL, "MSG") == SP_LOGGER_INVAlID_ARGUMENT);
+	site.function = "function";
+	ASSERT_TRUE(spLoggerPrintSite(&site, NULL) == SP_LOGGER_INVAlID_ARGUMENT);
+	ASSERT_TRUE(spLoggerPrintSite(&site, "MSG") == SP_LOGGER_SUCCESS);
+	spLoggerPrintError("MSG", "file", "function", 1);
+	spLoggerDestroy();
+	ASSERT_TRUE(spLoggerPrintSite(&site, "MSG") == SP_LOGGER_UNDIFINED);
+	ASSERT_TRUE(spLoggerDecode("binaryLoggerNotBinary.log", NULL) ==
+			SP_LOGGER_INVAlID_ARGUMENT);
+	// A site with an id the writer never assigns
+	const char malformed[] = "SPLOGB1\nS\xff\xff\xff\xff\x01\x01\x00\x00\x00"
+			"\x04\x00\x00\x00" "file" "\x04\x00\x00\x00" "func";
+	FILE* fp = fopen("binaryLoggerMalformed.bin", "wb");
+	ASSERT_TRUE(fp != NULL);
+	ASSERT_TRUE(fwrite(malformed, 1, sizeof(malformed) - 1, fp) == sizeof(malformed) - 1);
+	fclose(fp);
+	ASSERT_TRUE(spLoggerDecode("binaryLoggerMalformed.bin", "binaryLoggerMalformed.log") ==
+			SP_LOGGER_INVAlID_ARGUMENT);
+	return true;
+}
+static long fileSize(const char* filename) {
+	FILE* fp = fopen(filename, "r");
+	long size = -1;
+	if (fp != NULL) {
+		fseek(fp, 0, SEEK_END);
+		size = ftell(fp);
+		fclose(fp);
+	}
+	return size;
+}
+
+//The log is split between fileCount files of about maxBytes, holding the latest records
+static bool rotatingLoggerSizeTest() {
+	const char* testFile = "rotatingLoggerTest.log";
+	const char* files[] = { "rotatingLoggerTest.log", "rotatingLoggerTest.log.1",
+			"rotatingLoggerTest.log.2" };
+	char msg[32];
+	char line[64];
+	remove("rotatingLoggerTest.log.3");
+	ASSERT_TRUE(spLoggerCreateRotating(testFile, SP_LOGGER_ERROR_LEVEL, 16,
+			SP_LOGGER_OVERFLOW_BLOCK, 100, 0, 3) == SP_LOGGER_SUCCESS);
+	for (int i = 0; i < 100; i++) {
+		sprintf(msg, "%d", i);
+		ASSERT_TRUE(spLoggerPrintMsg(msg) == SP_LOGGER_SUCCESS);
+	}
+	spLoggerDestroy();
+	// Records of 14 bytes fill a file of 100 bytes with 8 records
+	int last = 99;
+	for (int i = 0; i < 3; i++) {
+		long size = fileSize(files[i]);
+		ASSERT_TRUE(size > 0 && size < 100 + 14);
+		FILE* fp = fopen(files[i], "r");
+		ASSERT_TRUE(fp != NULL);
+		int first = -1, previous = -1, current;
+		while (fgets(line, sizeof(line), fp) != NULL) {
+			ASSERT_TRUE(sscanf(line, "- message: %d", &current) == 1);
+			ASSERT_TRUE(previous == -1 || current == previous + 1);
+			first = first == -1 ? current : first;
+			previous = current;
+		}
+		fclose(fp);
+		ASSERT_TRUE(previous == last);
+		last = first - 1;
+	}
+	ASSERT_TRUE(fileSize("rotatingLoggerTest.log.3") == -1);
+	ASSERT_TRUE(fileSize("rotatingLoggerTest.log.next") == -1);
+	return true;
+}
+
+//Waits until the wall clock passed at least the given number of seconds
+static void waitSeconds(int seconds) {
+	pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+	pthread_cond_t never = PTHREAD_COND_INITIALIZER;
+	struct timespec deadline = { time(NULL) + seconds + 1, 0 };
+	pthread_mutex_lock(&lock);
+	while (pthread_cond_timedwait(&never, &lock, &deadline) == 0) {
+	}
+	pthread_mutex_unlock(&lock);
+}
+
+//A file older than maxSeconds is rotated before the next record
+static bool rotatingLoggerTimeTest() {
+	const char* testFile = "rotatingLoggerTimeTest.log";
+	remove("rotatingLoggerTimeTest.log.1");
+	ASSERT_TRUE(spLoggerCreateRotating(testFile, SP_LOGGER_ERROR_LEVEL, 16,
+			SP_LOGGER_OVERFLOW_BLOCK, 0, 1, 2) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintMsg("MSGA") == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintMsg("MSGB") == SP_LOGGER_SUCCESS);
+	waitSeconds(1);
+	ASSERT_TRUE(spLoggerPrintMsg("MSGC") == SP_LOGGER_SUCCESS);
+	spLoggerDestroy();
+	ASSERT_TRUE(fileSize("rotatingLoggerTimeTest.log.1") == 2 * 16);
+	ASSERT_TRUE(fileSize(testFile) == 16);
+	ASSERT_TRUE(spLoggerCreateRotating(NULL, SP_LOGGER_ERROR_LEVEL, 16,
+			SP_LOGGER_OVERFLOW_BLOCK, 0, 1, 2) == SP_LOGGER_INVAlID_ARGUMENT);
+	ASSERT_TRUE(spLoggerCreateRotating(testFile, SP_LOGGER_ERROR_LEVEL, 16,
+			SP_LOGGER_OVERFLOW_BLOCK, 0, 0, 2) == SP_LOGGER_INVAlID_ARGUMENT);
+	ASSERT_TRUE(spLoggerCreateRotating(testFile, SP_LOGGER_ERROR_LEVEL, 16,
+			SP_LOGGER_OVERFLOW_BLOCK, 100, 0, 0) == SP_LOGGER_INVAlID_ARGUMENT);
+	return true;
+}
+//One in n records is printed, and the suppressed records are counted
+static bool sampledLoggerTest() {
+	const char* testFile = "sampledLoggerTest.log";
+	char msg[32];
+	char messages[16][64];
+	const char* expected[] = { "0\n", "3 log records of this call site were suppressed\n",
+			"4\n", "8\n" };
+	ASSERT_TRUE(spLoggerCreate(testFile, SP_LOGGER_WARNING_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	for (int i = 0; i < 10; i++) {
+		sprintf(msg, "%d", i);
+		SP_LOG_EVERY(WARNING, 4, msg);
+		SP_LOG_EVERY(INFO, 1, "MSGC"); // Filtered by the level
+	}
+	spLoggerDestroy();
+	ASSERT_TRUE(readMessages(testFile, messages, 16) == 4);
+	for (int i = 0; i < 4; i++) {
+		ASSERT_TRUE(strcmp(messages[i], expected[i]) == 0);
+	}
+	return true;
+}
+
+//A token bucket allows a burst, and then records at its rate
+static bool rateLimitedLoggerTest() {
+	const char* testFile = "rateLimitedLoggerTest.log";
+	char messages[16][64];
+	SPLoggerBucket bucket = { 0, 0 };
+	ASSERT_TRUE(spLoggerTakeToken(&bucket, 0.001, 2));
+	ASSERT_TRUE(spLoggerTakeToken(&bucket, 0.001, 2));
+	ASSERT_FALSE(spLoggerTakeToken(&bucket, 0.001, 2));
+	ASSERT_TRUE(spLoggerTakeToken(&bucket, 1e12, 2)); // Refilled at once
+	ASSERT_TRUE(spLoggerCreate(testFile, SP_LOGGER_ERROR_LEVEL) == SP_LOGGER_SUCCESS);
+	for (int i = 0; i < 100; i++) {
+		SP_LOG_LIMITED(MSG, 0.001, 3, "MSG");
+	}
+	spLoggerDestroy();
+	ASSERT_TRUE(readMessages(testFile, messages, 16) == 3);
+	return true;
+}
+//A flight recorder keeps the last records in order, readable before it is destroyed
+static bool flightRecorderTest() {
+	const char* testFile = "flightRecorderTest.rec";
+	const char* decodedFile = "flightRecorderTest.log";
+	char msg[32];
+	char messages[16][64];
+	char expected[64];
+	ASSERT_TRUE(spLoggerCreateFlightRecorder(testFile, SP_LOGGER_WARNING_ERROR_LEVEL, 8) ==
+			SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerDecode(testFile, decodedFile) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(readMessages(decodedFile, messages, 16) == 0);
+	for (int i = 0; i < 20; i++) {
+		sprintf(msg, "%d", i);
+		ASSERT_TRUE(spLoggerPrintWarning(msg, "file", "function", i) == SP_LOGGER_SUCCESS);
+		ASSERT_TRUE(spLoggerPrintDebug(msg, "file", "function", i) == SP_LOGGER_SUCCESS);
+	}
+	// The records are in the file while the recorder is still open
+	ASSERT_TRUE(spLoggerDecode(testFile, decodedFile) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(readMessages(decodedFile, messages, 16) == 8);
+	for (int i = 0; i < 8; i++) {
+		sprintf(expected, "%d\n", 12 + i);
+		ASSERT_TRUE(strcmp(messages[i], expected) == 0);
+	}
+	spLoggerDestroy();
+	ASSERT_TRUE(spLoggerDecode(testFile, decodedFile) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(readMessages(decodedFile, messages, 16) == 8);
+	ASSERT_TRUE(spLoggerCreateFlightRecorder(NULL, SP_LOGGER_ERROR_LEVEL, 8) ==
+			SP_LOGGER_INVAlID_ARGUMENT);
+	ASSERT_TRUE(spLoggerCreateFlightRecorder(testFile, SP_LOGGER_ERROR_LEVEL, 0) ==
+			SP_LOGGER_INVAlID_ARGUMENT);
+	return true;
+}
+
+//A new recorder keeps the file of the previous one, which is not truncated
+static bool flightRecorderPreviousFileTest() {
+	const char* testFile = "flightRecorderPrevious.rec";
+	const char* previousFile = "flightRecorderPrevious.rec.prev";
+	const char* decodedFile = "flightRecorderPrevious.log";
+	char messages[16][64];
+	remove(previousFile);
+	ASSERT_TRUE(spLoggerCreateFlightRecorder(testFile, SP_LOGGER_ERROR_LEVEL, 4) ==
+			SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintMsg("OLD1") == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintMsg("OLD2") == SP_LOGGER_SUCCESS);
+	spLoggerDestroy();
+	ASSERT_TRUE(spLoggerCreateFlightRecorder(testFile, SP_LOGGER_ERROR_LEVEL, 4) ==
+			SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintMsg("NEW") == SP_LOGGER_SUCCESS);
+	// The previous records are readable while the new recorder is open
+	ASSERT_TRUE(spLoggerDecode(previousFile, decodedFile) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(readMessages(decodedFile, messages, 16) == 2);
+	ASSERT_TRUE(strcmp(messages[0], "OLD1\n") == 0 && strcmp(messages[1], "OLD2\n") == 0);
+	spLoggerDestroy();
+	ASSERT_TRUE(spLoggerDecode(testFile, decodedFile) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(readMessages(decodedFile, messages, 16) == 1);
+	ASSERT_TRUE(strcmp(messages[0], "NEW\n") == 0);
+	return true;
+}
+
+//A record whose slot another thread is still writing is dropped and counted
+static bool flightRecorderBusySlotTest() {
+	const char* testFile = "flightRecorderBusy.rec";
+	const char* decodedFile = "flightRecorderBusy.log";
+	const unsigned char busy[8] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+	char messages[16][64];
+	ASSERT_TRUE(spLoggerCreateFlightRecorder(testFile, SP_LOGGER_ERROR_LEVEL, 4) ==
+			SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintMsg("MSGA") == SP_LOGGER_SUCCESS);
+	// Mark the second slot, after the 24 bytes header and the first slot, as being written
+	FILE* fp = fopen(testFile, "r+b");
+	ASSERT_TRUE(fp != NULL);
+	ASSERT_TRUE(fseek(fp, 24 + 256, SEEK_SET) == 0);
+	ASSERT_TRUE(fwrite(busy, 1, sizeof(busy), fp) == sizeof(busy));
+	fclose(fp);
+	ASSERT_TRUE(spLoggerPrintMsg("MSGB") == SP_LOGGER_BUFFER_FULL);
+	ASSERT_TRUE(spLoggerGetDroppedCount() == 1);
+	ASSERT_TRUE(spLoggerPrintMsg("MSGC") == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerDecode(testFile, decodedFile) == SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(readMessages(decodedFile, messages, 16) == 2);
+	ASSERT_TRUE(strcmp(messages[0], "MSGA\n") == 0 && strcmp(messages[1], "MSGC\n") == 0);
+	spLoggerDestroy();
+	return true;
+}
+
+//Long strings are cut to fit a slot, keeping the record readable
+static bool flightRecorderLongRecordTest() {
+	const char* testFile = "flightRecorderLongTest.rec";
+	const char* decodedFile = "flightRecorderLongTest.log";
+	char longText[400];
+	char line[512];
+	memset(longText, 'x', sizeof(longText) - 1);
+	longText[sizeof(longText) - 1] = '\0';
+	ASSERT_TRUE(spLoggerCreateFlightRecorder(testFile, SP_LOGGER_ERROR_LEVEL, 2) ==
+			SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintError(longText, longText, longText, 7) == SP_LOGGER_SUCCESS);
+	spLoggerDestroy();
+	ASSERT_TRUE(spLoggerDecode(testFile, decodedFile) == SP_LOGGER_SUCCESS);
+	FILE* fp = fopen(decodedFile, "r");
+	ASSERT_TRUE(fp != NULL);
+	ASSERT_TRUE(fgets(line, sizeof(line), fp) != NULL && strcmp(line, "---ERROR---\n") == 0);
+	ASSERT_TRUE(fgets(line, sizeof(line), fp) != NULL && strlen(line) == 8 + 63 + 1);
+	ASSERT_TRUE(fgets(line, sizeof(line), fp) != NULL && strlen(line) == 12 + 63 + 1);
+	ASSERT_TRUE(fgets(line, sizeof(line), fp) != NULL && strcmp(line, "- line: 7\n") == 0);
+	ASSERT_TRUE(fgets(line, sizeof(line), fp) != NULL && strlen(line) > 11 + 64);
+	ASSERT_TRUE(fgets(line, sizeof(line), fp) == NULL);
+	fclose(fp);
+	return true;
+}
+//A recorder file whose header does not match its size is rejected before the slots are read
+static bool flightRecorderDamagedTest() {
+	const char* testFile = "flightRecorderDamaged.rec";
+	const char* decodedFile = "flightRecorderDamaged.log";
+	const unsigned char slotCount[4] = { 0xff, 0xff, 0xff, 0xff };
+	char buffer[24 + 4 * 256];
+	ASSERT_TRUE(spLoggerCreateFlightRecorder(testFile, SP_LOGGER_ERROR_LEVEL, 4) ==
+			SP_LOGGER_SUCCESS);
+	ASSERT_TRUE(spLoggerPrintMsg("MSG") == SP_LOGGER_SUCCESS);
+	spLoggerDestroy();
+	FILE* fp = fopen(testFile, "rb");
+	ASSERT_TRUE(fp != NULL);
+	ASSERT_TRUE(fread(buffer, 1, sizeof(buffer), fp) == sizeof(buffer));
+	fclose(fp);
+	// The last slot is cut
+	fp = fopen(testFile, "wb");
+	ASSERT_TRUE(fp != NULL);
+	ASSERT_TRUE(fwrite(buffer, 1, sizeof(buffer) - 100, fp) == sizeof(buffer) - 100);
+	fclose(fp);
+	ASSERT_TRUE(spLoggerDecode(testFile, decodedFile) == SP_LOGGER_INVAlID_ARGUMENT);
+	// The slot count, after the magic and the slot size, claims about 1 TB of slots
+	memcpy(buffer + 12, slotCount, sizeof(slotCount));
+	fp = fopen(testFile, "wb");
+	ASSERT_TRUE(fp != NULL);
+	ASSERT_TRUE(fwrite(buffer, 1, sizeof(buffer), fp) == sizeof(buffer));
+	fclose(fp);
+	ASSERT_TRUE(spLoggerDecode(testFile, decodedFile) == SP_LOGGER_INVAlID_ARGUMENT);
+	return true;
+}
 ///*
 int main() {
 	RUN_TEST(basicLoggerTest);
@@ -138,6 +782,25 @@ int main() {
 	RUN_TEST(basicLoggerMsgTest);
 	RUN_TEST(basicLoggerArgumentTest);
 	RUN_TEST(basicLoggerDestroyUndefinedTest);
+	RUN_TEST(asyncLoggerLevelTest);
+	RUN_TEST(asyncLoggerBlockTest);
+	RUN_TEST(asyncLoggerDropTest);
+	RUN_TEST(concurrentLoggerRecordsTest);
+	RUN_TEST(concurrentLoggerCreateDestroyTest);
+	RUN_TEST(loggerMacrosTest);
+	RUN_TEST(binaryLoggerDecodeTest);
+	RUN_TEST(binaryLoggerTruncatedTest);
+	RUN_TEST(binaryLoggerUnknownSiteTest);
+	RUN_TEST(binaryLoggerArgumentTest);
+	RUN_TEST(rotatingLoggerSizeTest);
+	RUN_TEST(rotatingLoggerTimeTest);
+	RUN_TEST(sampledLoggerTest);
+	RUN_TEST(rateLimitedLoggerTest);
+	RUN_TEST(flightRecorderTest);
+	RUN_TEST(flightRecorderPreviousFileTest);
+	RUN_TEST(flightRecorderBusySlotTest);
+	RUN_TEST(flightRecorderLongRecordTest);
+	RUN_TEST(flightRecorderDamagedTest);
 
 	return 0;
 }
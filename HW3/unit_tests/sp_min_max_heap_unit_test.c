@@ -0,0 +1,96 @@
+#include "../SPMinMaxHeap.h"
+#include "../SPListElement.h"
+#include "unit_test_util.h"
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define RANDOM_CAPACITY 50
+
+static bool minMaxHeapCreateTest() {
+	SPMinMaxHeap heap = spMinMaxHeapCreate(3);
+	ASSERT_TRUE(heap != NULL);
+	ASSERT_TRUE(spMinMaxHeapCreate(0) == NULL);
+	ASSERT_TRUE(spMinMaxHeapGetSize(heap) == 0);
+	ASSERT_TRUE(spMinMaxHeapGetCapacity(heap) == 3);
+	ASSERT_TRUE(spMinMaxHeapGetSize(NULL) == -1);
+	ASSERT_TRUE(spMinMaxHeapGetMin(heap) == NULL);
+	ASSERT_TRUE(spMinMaxHeapGetMax(heap) == NULL);
+	ASSERT_TRUE(spMinMaxHeapRemoveMin(heap) == SP_MINMAX_HEAP_EMPTY);
+	ASSERT_TRUE(spMinMaxHeapRemoveMax(NULL) == SP_MINMAX_HEAP_NULL_ARGUMENT);
+	spMinMaxHeapDestroy(heap);
+	return true;
+}
+
+static bool minMaxHeapInsertTest() {
+	SPMinMaxHeap heap = spMinMaxHeapCreate(3);
+	SPMinMaxHeap copy;
+	SPListElement e1 = spListElementCreate(1, 2.0);
+	SPListElement e2 = spListElementCreate(2, 1.0);
+	SPListElement e3 = spListElementCreate(3, 3.0);
+	ASSERT_TRUE(spMinMaxHeapInsert(heap, NULL) == SP_MINMAX_HEAP_NULL_ARGUMENT);
+	ASSERT_TRUE(spMinMaxHeapInsert(heap, e1) == SP_MINMAX_HEAP_SUCCESS);
+	ASSERT_TRUE(spListElementGetIndex(spMinMaxHeapGetMin(heap)) == 1);
+	ASSERT_TRUE(spListElementGetIndex(spMinMaxHeapGetMax(heap)) == 1);
+	ASSERT_TRUE(spMinMaxHeapInsert(heap, e2) == SP_MINMAX_HEAP_SUCCESS);
+	ASSERT_TRUE(spMinMaxHeapInsert(heap, e3) == SP_MINMAX_HEAP_SUCCESS);
+	ASSERT_TRUE(spMinMaxHeapInsert(heap, e3) == SP_MINMAX_HEAP_FULL);
+	ASSERT_TRUE(spListElementGetIndex(spMinMaxHeapGetMin(heap)) == 2);
+	ASSERT_TRUE(spListElementGetIndex(spMinMaxHeapGetMax(heap)) == 3);
+	copy = spMinMaxHeapCopy(heap);
+	ASSERT_TRUE(spMinMaxHeapRemoveMax(heap) == SP_MINMAX_HEAP_SUCCESS);
+	ASSERT_TRUE(spListElementGetIndex(spMinMaxHeapGetMax(heap)) == 1);
+	ASSERT_TRUE(spMinMaxHeapGetSize(copy) == 3);
+	ASSERT_TRUE(spListElementGetIndex(spMinMaxHeapGetMax(copy)) == 3);
+	spMinMaxHeapClear(heap);
+	ASSERT_TRUE(spMinMaxHeapGetSize(heap) == 0);
+	spListElementDestroy(e1);
+	spListElementDestroy(e2);
+	spListElementDestroy(e3);
+	spMinMaxHeapDestroy(copy);
+	spMinMaxHeapDestroy(heap);
+	return true;
+}
+
+// Random operations checked against a brute-force scan of the heap's array
+static bool minMaxHeapRandomTest() {
+	SPMinMaxHeap heap = spMinMaxHeapCreate(RANDOM_CAPACITY);
+	SPListElement element = spListElementCreate(0, 0.0);
+	SPListElement min, max, current;
+	unsigned int seed = 777;
+	int i, j, size;
+	for (i = 0; i < 20000; i++) {
+		seed = seed * 1103515245u + 12345u;
+		size = spMinMaxHeapGetSize(heap);
+		if (size < RANDOM_CAPACITY && (seed >> 8) % 3 != 0) {
+			spListElementSetIndex(element, (int) ((seed >> 4) % 100));
+			spListElementSetValue(element, (double) ((seed >> 12) % 20));
+			ASSERT_TRUE(spMinMaxHeapInsert(heap, element) == SP_MINMAX_HEAP_SUCCESS);
+		} else if ((seed >> 16) % 2 == 0) {
+			spMinMaxHeapRemoveMin(heap);
+		} else {
+			spMinMaxHeapRemoveMax(heap);
+		}
+		size = spMinMaxHeapGetSize(heap);
+		if (size == 0) {
+			continue;
+		}
+		min = spMinMaxHeapGetMin(heap);
+		max = spMinMaxHeapGetMax(heap);
+		for (j = 0; j < size; j++) {
+			current = spMinMaxHeapGetAt(heap, j);
+			ASSERT_TRUE(spListElementCompare(min, current) <= 0);
+			ASSERT_TRUE(spListElementCompare(max, current) >= 0);
+		}
+	}
+	ASSERT_TRUE(spMinMaxHeapGetAt(heap, -1) == NULL);
+	spListElementDestroy(element);
+	spMinMaxHeapDestroy(heap);
+	return true;
+}
+
+int main() {
+	RUN_TEST(minMaxHeapCreateTest);
+	RUN_TEST(minMaxHeapInsertTest);
+	RUN_TEST(minMaxHeapRandomTest);
+	return 0;
+}
@@ -0,0 +1,60 @@
+#include "unit_test_util.h"
+#include "../SPListElement.h"
+#include "../SPPackedElement.h"
+#include <stdbool.h>
+
+static bool packedElementRoundTripTest() {
+	int indexes[] = { 0, 1, 7, 1000, 2147483647 };
+	double values[] = { 0.0, 0.5, 1.0, 3.25, 1e30, -2.5 };
+	for (int i = 0; i < 5; i++) {
+		for (int j = 0; j < 6; j++) {
+			SPPackedElement packed = spPackedElementCreate(indexes[i], values[j]);
+			ASSERT_TRUE(spPackedElementGetIndex(packed) == indexes[i]);
+			ASSERT_TRUE(spPackedElementGetValue(packed) == (float) values[j]);
+			SPListElementValue unpacked = spPackedElementToValue(packed);
+			ASSERT_TRUE(unpacked.index == indexes[i] && unpacked.value == (float) values[j]);
+			ASSERT_TRUE(spPackedElementFromValue(unpacked) == packed);
+			ASSERT_TRUE(packed != SP_PACKED_ELEMENT_MAX);
+		}
+	}
+	ASSERT_TRUE(spPackedElementCreate(3, -0.0) == spPackedElementCreate(3, 0.0));
+	return true;
+}
+
+static bool packedElementOrderTest() {
+	SPPackedElement packed = spPackedElementCreate(2, 1.5);
+	ASSERT_TRUE(spPackedElementCompare(packed, packed) == 0);
+	ASSERT_TRUE(spPackedElementCompare(packed, spPackedElementCreate(3, 1.5)) == -1);
+	ASSERT_TRUE(spPackedElementCompare(packed, spPackedElementCreate(0, 1.0)) == 1);
+	ASSERT_TRUE(spPackedElementCreate(100, -1.0) < spPackedElementCreate(0, 0.0));
+	ASSERT_TRUE(spPackedElementCreate(0, -2.0) < spPackedElementCreate(0, -1.0));
+	// Random pairs of float precision values order as spListElementCompare
+	unsigned int seed = 12345;
+	for (int i = 0; i < 10000; i++) {
+		SPListElementValue e[2];
+		for (int j = 0; j < 2; j++) {
+			seed = seed * 1103515245u + 12345u;
+			int index = (int) ((seed >> 8) % 16);
+			seed = seed * 1103515245u + 12345u;
+			double value = (double) (float) ((int) ((seed >> 8) % 64) - 16) / 8.0;
+			e[j] = spListElementValueCreate(index, value);
+		}
+		SPListElement handle = spListElementCreateFromValue(e[0]);
+		SPListElement other = spListElementCreateFromValue(e[1]);
+		int expected = spListElementValueCompare(e[0], e[1]);
+		ASSERT_TRUE(spPackedElementCompare(spPackedElementFromValue(e[0]),
+				spPackedElementFromValue(e[1])) == expected);
+		if (handle && other) {		// Handles hold non-negative values only
+			ASSERT_TRUE(spListElementCompare(handle, other) == expected);
+		}
+		spListElementDestroy(handle);
+		spListElementDestroy(other);
+	}
+	return true;
+}
+
+int main() {
+	RUN_TEST(packedElementRoundTripTest);
+	RUN_TEST(packedElementOrderTest);
+	return 0;
+}
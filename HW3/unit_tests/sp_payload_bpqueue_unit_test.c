@@ -0,0 +1,105 @@
+#include "../SPPayloadBPQueue.h"
+#include "unit_test_util.h"
+#include <stdbool.h>
+#include <string.h>
+
+/** A typical search result payload **/
+typedef struct result_payload_t {
+	int imageId;
+	long offset;
+	float score;
+} ResultPayload;
+
+static bool payloadBPQueueCreateTest() {
+	SPPayloadBPQueue queue = spPayloadBPQueueCreate(4, sizeof(ResultPayload));
+	ASSERT_TRUE(queue != NULL);
+	ASSERT_TRUE(spPayloadBPQueueCreate(0, sizeof(ResultPayload)) == NULL);
+	ASSERT_TRUE(spPayloadBPQueueGetMaxSize(queue) == 4);
+	ASSERT_TRUE(spPayloadBPQueueGetPayloadSize(queue) == sizeof(ResultPayload));
+	ASSERT_TRUE(spPayloadBPQueueSize(queue) == 0);
+	ASSERT_TRUE(spPayloadBPQueueSize(NULL) == -1);
+	ASSERT_TRUE(spPayloadBPQueueIsEmpty(queue));
+	ASSERT_TRUE(spPayloadBPQueueMinValue(queue) == -1);
+	ASSERT_FALSE(spPayloadBPQueuePeek(queue, NULL, NULL, NULL));
+	spPayloadBPQueueDestroy(queue);
+	return true;
+}
+
+static bool payloadBPQueueEnqueueTest() {
+	SPPayloadBPQueue queue = spPayloadBPQueueCreate(3, sizeof(ResultPayload));
+	ResultPayload payload;
+	const void* stored;
+	int i, index;
+	double value;
+	ASSERT_TRUE(spPayloadBPQueueEnqueue(queue, 1, 1.0, NULL) == SP_BPQUEUE_INVALID_ARGUMENT);
+	ASSERT_TRUE(spPayloadBPQueueEnqueue(queue, -1, 1.0, &payload) == SP_BPQUEUE_INVALID_ARGUMENT);
+	for (i = 0; i < 6; i++) {
+		payload.imageId = i;
+		payload.offset = i * 100L;
+		payload.score = (float) i / 2;
+		spPayloadBPQueueEnqueue(queue, i, (double) ((i * 5) % 6), &payload);
+	}
+	// Values are 0, 5, 4, 3, 2, 1 so the queue holds indexes 0, 5, 4
+	ASSERT_TRUE(spPayloadBPQueueIsFull(queue));
+	ASSERT_TRUE(spPayloadBPQueueMinValue(queue) == 0.0);
+	ASSERT_TRUE(spPayloadBPQueueMaxValue(queue) == 2.0);
+	ASSERT_TRUE(spPayloadBPQueueGetAt(queue, 1, &index, &value, &stored));
+	ASSERT_TRUE(index == 5 && value == 1.0);
+	memcpy(&payload, stored, sizeof(payload));
+	ASSERT_TRUE(payload.imageId == 5 && payload.offset == 500L && payload.score == 2.5f);
+	ASSERT_TRUE(spPayloadBPQueuePeekLast(queue, &index, NULL, &stored));
+	ASSERT_TRUE(index == 4 && ((const ResultPayload*) stored)->imageId == 4);
+	payload.imageId = 42;
+	ASSERT_TRUE(spPayloadBPQueueEnqueue(queue, 9, 2.0, &payload) == SP_BPQUEUE_FULL);
+	ASSERT_TRUE(spPayloadBPQueueEnqueue(queue, 3, 2.0, &payload) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spPayloadBPQueuePeekLast(queue, &index, NULL, &stored));
+	ASSERT_TRUE(index == 3 && ((const ResultPayload*) stored)->imageId == 42);
+	spPayloadBPQueueDestroy(queue);
+	return true;
+}
+
+static bool payloadBPQueueDequeueTest() {
+	SPPayloadBPQueue queue = spPayloadBPQueueCreate(8, sizeof(int)), copy;
+	const void* stored;
+	int i, index, expected;
+	for (i = 0; i < 20; i++) {
+		expected = i * 7;
+		spPayloadBPQueueEnqueue(queue, i, (double) ((i * 13) % 20), &expected);
+	}
+	copy = spPayloadBPQueueCopy(queue);
+	ASSERT_TRUE(copy != NULL && spPayloadBPQueueSize(copy) == 8);
+	for (i = 0; i < 8; i++) {
+		ASSERT_TRUE(spPayloadBPQueuePeek(queue, &index, NULL, &stored));
+		ASSERT_TRUE((index * 13) % 20 == i);
+		memcpy(&expected, stored, sizeof(int));
+		ASSERT_TRUE(expected == index * 7);
+		ASSERT_TRUE(spPayloadBPQueueDequeue(queue) == SP_BPQUEUE_SUCCESS);
+	}
+	ASSERT_TRUE(spPayloadBPQueueDequeue(queue) == SP_BPQUEUE_EMPTY);
+	ASSERT_TRUE(spPayloadBPQueueMinValue(copy) == 0.0);
+	spPayloadBPQueueClear(copy);
+	ASSERT_TRUE(spPayloadBPQueueIsEmpty(copy));
+	spPayloadBPQueueDestroy(copy);
+	spPayloadBPQueueDestroy(queue);
+	return true;
+}
+
+static bool payloadBPQueueEmptyPayloadTest() {
+	SPPayloadBPQueue queue = spPayloadBPQueueCreate(2, 0);
+	int index;
+	ASSERT_TRUE(spPayloadBPQueueEnqueue(queue, 1, 3.0, NULL) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spPayloadBPQueueEnqueue(queue, 2, 3.0, NULL) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spPayloadBPQueueEnqueue(queue, 0, 3.0, NULL) == SP_BPQUEUE_SUCCESS);
+	ASSERT_TRUE(spPayloadBPQueuePeek(queue, &index, NULL, NULL) && index == 0);
+	ASSERT_TRUE(spPayloadBPQueuePeekLast(queue, &index, NULL, NULL) && index == 1);
+	spPayloadBPQueueDestroy(queue);
+	return true;
+}
+
+int main() {
+	RUN_TEST(payloadBPQueueCreateTest);
+	RUN_TEST(payloadBPQueueEnqueueTest);
+	RUN_TEST(payloadBPQueueDequeueTest);
+	RUN_TEST(payloadBPQueueEmptyPayloadTest);
+	return 0;
+}
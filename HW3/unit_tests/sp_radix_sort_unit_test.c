@@ -0,0 +1,102 @@
+#include "unit_test_util.h"
+#include "../SPListElement.h"
+#include "../SPRadixSort.h"
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define ELEMENTS 20000
+
+static int compareValues(const void* e1, const void* e2) {
+	return spListElementValueCompare(*(const SPListElementValue*) e1,
+			*(const SPListElementValue*) e2);
+}
+
+/*
+ * Fills the arrays with random elements, and expected with the same elements
+ * in sorted order.
+ */
+static void createElements(int* indexes, double* values, SPListElementValue* expected,
+		int n, unsigned int seed, bool negative) {
+	for (int i = 0; i < n; i++) {
+		seed = seed * 1103515245u + 12345u;
+		indexes[i] = (int) ((seed >> 8) % 1000) * (i % 3 == 0 ? 100000 : 1);
+		seed = seed * 1103515245u + 12345u;
+		values[i] = (double) ((seed >> 8) % 500) / 7.0 - (negative ? 35.0 : 0.0);
+		expected[i] = spListElementValueCreate(indexes[i], values[i]);
+	}
+	qsort(expected, n, sizeof(SPListElementValue), compareValues);
+}
+
+static bool isSorted(const int* indexes, const double* values,
+		const SPListElementValue* expected, int n) {
+	for (int i = 0; i < n; i++) {
+		if (indexes[i] != expected[i].index || values[i] != expected[i].value) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool radixSortArgumentsTest() {
+	int indexes[3] = { 2, 1, 0 };
+	double values[3] = { 1.0, -0.0, 0.0 };
+	ASSERT_TRUE(spRadixSort(NULL, values, 3) == SP_RADIX_SORT_INVALID_ARGUMENT);
+	ASSERT_TRUE(spRadixSort(indexes, NULL, 3) == SP_RADIX_SORT_INVALID_ARGUMENT);
+	ASSERT_TRUE(spRadixSort(indexes, values, -1) == SP_RADIX_SORT_INVALID_ARGUMENT);
+	ASSERT_TRUE(spRadixSortParallel(indexes, values, 3, 0) == SP_RADIX_SORT_INVALID_ARGUMENT);
+	ASSERT_TRUE(spRadixSort(NULL, NULL, 0) == SP_RADIX_SORT_SUCCESS);
+	ASSERT_TRUE(spRadixSort(indexes, values, 1) == SP_RADIX_SORT_SUCCESS);
+	ASSERT_TRUE(indexes[0] == 2 && values[0] == 1.0);
+	ASSERT_TRUE(spRadixSort(indexes, values, 3) == SP_RADIX_SORT_SUCCESS);
+	// -0.0 and 0.0 are equal, so the elements are ordered by index
+	ASSERT_TRUE(indexes[0] == 0 && indexes[1] == 1 && indexes[2] == 2);
+	ASSERT_TRUE(values[0] == 0.0 && values[1] == 0.0 && values[2] == 1.0);
+	return true;
+}
+
+static bool radixSortRandomTest() {
+	int* indexes = (int*) malloc(sizeof(int) * ELEMENTS);
+	double* values = (double*) malloc(sizeof(double) * ELEMENTS);
+	SPListElementValue* expected = (SPListElementValue*) malloc(sizeof(SPListElementValue) * ELEMENTS);
+	ASSERT_TRUE(indexes && values && expected);
+	for (int negative = 0; negative < 2; negative++) {
+		createElements(indexes, values, expected, ELEMENTS, 17 + negative, negative);
+		ASSERT_TRUE(spRadixSort(indexes, values, ELEMENTS) == SP_RADIX_SORT_SUCCESS);
+		ASSERT_TRUE(isSorted(indexes, values, expected, ELEMENTS));
+		// Sorting sorted elements keeps them
+		ASSERT_TRUE(spRadixSort(indexes, values, ELEMENTS) == SP_RADIX_SORT_SUCCESS);
+		ASSERT_TRUE(isSorted(indexes, values, expected, ELEMENTS));
+	}
+	free(indexes);
+	free(values);
+	free(expected);
+	return true;
+}
+
+static bool radixSortParallelTest() {
+	int sizes[] = { 2, 5, 1000, ELEMENTS };
+	int threads[] = { 1, 2, 3, 8 };
+	int* indexes = (int*) malloc(sizeof(int) * ELEMENTS);
+	double* values = (double*) malloc(sizeof(double) * ELEMENTS);
+	SPListElementValue* expected = (SPListElementValue*) malloc(sizeof(SPListElementValue) * ELEMENTS);
+	ASSERT_TRUE(indexes && values && expected);
+	for (int s = 0; s < 4; s++) {
+		for (int t = 0; t < 4; t++) {
+			createElements(indexes, values, expected, sizes[s], 5 + s * 4 + t, t % 2 == 1);
+			ASSERT_TRUE(spRadixSortParallel(indexes, values, sizes[s], threads[t]) ==
+					SP_RADIX_SORT_SUCCESS);
+			ASSERT_TRUE(isSorted(indexes, values, expected, sizes[s]));
+		}
+	}
+	free(indexes);
+	free(values);
+	free(expected);
+	return true;
+}
+
+int main() {
+	RUN_TEST(radixSortArgumentsTest);
+	RUN_TEST(radixSortRandomTest);
+	RUN_TEST(radixSortParallelTest);
+	return 0;
+}
@@ -0,0 +1,113 @@
+#include "unit_test_util.h"
+#include "../SPListElement.h"
+#include "../SPSkipList.h"
+#include <stdbool.h>
+
+#define ELEMENTS 2000
+
+/*
+ * Decides whether the skip list is sorted, and whether its ranks agree
+ * with its order.
+ */
+static bool isConsistent(SPSkipList list) {
+	SPListElement previous = NULL;
+	int rank = 0;
+	for (SPListElement e = spSkipListGetFirst(list); e; e = spSkipListGetNext(list)) {
+		if (previous && spListElementCompare(previous, e) > 0) {
+			return false;
+		}
+		if (spSkipListGetAt(list, rank) != e) {
+			return false;
+		}
+		// Equal elements share the rank of the first of them
+		if (spSkipListRank(list, e) != (previous && spListElementCompare(previous, e) == 0 ?
+				spSkipListRank(list, previous) : rank)) {
+			return false;
+		}
+		previous = e;
+		rank++;
+	}
+	return rank == spSkipListGetSize(list) && spSkipListGetMax(list) == previous;
+}
+
+static bool skipListCreateTest() {
+	SPSkipList list = spSkipListCreate();
+	SPListElement e = spListElementCreate(1, 1.0);
+	ASSERT_TRUE(list != NULL);
+	ASSERT_TRUE(spSkipListGetSize(list) == 0);
+	ASSERT_TRUE(spSkipListGetSize(NULL) == -1);
+	ASSERT_TRUE(spSkipListGetMin(list) == NULL && spSkipListGetMax(list) == NULL);
+	ASSERT_TRUE(spSkipListGetAt(list, 0) == NULL);
+	ASSERT_TRUE(spSkipListRank(list, e) == 0);
+	ASSERT_TRUE(spSkipListRemoveMin(list) == SP_SKIP_LIST_EMPTY);
+	ASSERT_TRUE(spSkipListRemove(list, e) == SP_SKIP_LIST_NOT_FOUND);
+	ASSERT_TRUE(spSkipListInsert(NULL, e) == SP_SKIP_LIST_NULL_ARGUMENT);
+	spSkipListDestroy(list);
+	spListElementDestroy(e);
+	return true;
+}
+
+static bool skipListOrderTest() {
+	SPSkipList list = spSkipListCreate();
+	SPListElement e = spListElementCreate(0, 0.0);
+	int i;
+	for (i = 0; i < ELEMENTS; i++) {
+		spListElementSetIndex(e, i);
+		spListElementSetValue(e, (double) ((i * 7919) % 101));
+		ASSERT_TRUE(spSkipListInsert(list, e) == SP_SKIP_LIST_SUCCESS);
+	}
+	ASSERT_TRUE(spSkipListGetSize(list) == ELEMENTS);
+	ASSERT_TRUE(isConsistent(list));
+	ASSERT_TRUE(spListElementGetValue(spSkipListGetMin(list)) == 0.0);
+	ASSERT_TRUE(spListElementGetValue(spSkipListGetMax(list)) == 100.0);
+	for (i = 0; i < ELEMENTS; i += 2) {
+		spListElementSetIndex(e, i);
+		spListElementSetValue(e, (double) ((i * 7919) % 101));
+		ASSERT_TRUE(spSkipListContains(list, e));
+		ASSERT_TRUE(spSkipListRemove(list, e) == SP_SKIP_LIST_SUCCESS);
+		ASSERT_FALSE(spSkipListContains(list, e));
+	}
+	ASSERT_TRUE(spSkipListGetSize(list) == ELEMENTS / 2);
+	ASSERT_TRUE(isConsistent(list));
+	for (i = 0; i < 100; i++) {
+		ASSERT_TRUE(spSkipListRemoveMin(list) == SP_SKIP_LIST_SUCCESS);
+		ASSERT_TRUE(spSkipListRemoveMax(list) == SP_SKIP_LIST_SUCCESS);
+	}
+	ASSERT_TRUE(isConsistent(list));
+	ASSERT_TRUE(spSkipListClear(list) == SP_SKIP_LIST_SUCCESS);
+	ASSERT_TRUE(spSkipListGetSize(list) == 0 && spSkipListGetFirst(list) == NULL);
+	spSkipListDestroy(list);
+	spListElementDestroy(e);
+	return true;
+}
+
+static bool skipListDuplicatesTest() {
+	SPSkipList list = spSkipListCreate();
+	SPListElement e = spListElementCreate(3, 2.0);
+	SPListElement other = spListElementCreate(1, 2.0);
+	int i;
+	for (i = 0; i < 10; i++) {
+		spSkipListInsert(list, e);
+	}
+	spSkipListInsert(list, other);
+	ASSERT_TRUE(spSkipListRank(list, e) == 1);
+	ASSERT_TRUE(spSkipListGetMin(list) != NULL &&
+			spListElementGetIndex(spSkipListGetMin(list)) == 1);
+	ASSERT_TRUE(spSkipListRemoveMax(list) == SP_SKIP_LIST_SUCCESS);
+	ASSERT_TRUE(spSkipListRemove(list, e) == SP_SKIP_LIST_SUCCESS);
+	ASSERT_TRUE(spSkipListGetSize(list) == 9);
+	ASSERT_TRUE(isConsistent(list));
+	ASSERT_TRUE(spListElementGetIndex(spSkipListGetLast(list)) == 3);
+	ASSERT_TRUE(spSkipListGetPrevious(list) != NULL);
+	spSkipListDestroy(list);
+	spListElementDestroy(e);
+	spListElementDestroy(other);
+	return true;
+}
+
+int main() {
+	RUN_TEST(skipListCreateTest);
+	RUN_TEST(skipListOrderTest);
+	RUN_TEST(skipListDuplicatesTest);
+	return 0;
+}
@@ -0,0 +1,150 @@
+#include "unit_test_util.h"
+#include "../SPListElement.h"
+#include "../SPList.h"
+#include "../SPUnrolledList.h"
+#include <stdbool.h>
+
+#define OPERATIONS 5000
+
+/*
+ * Decides whether both lists hold the same elements in the same order,
+ * walking them in both directions.
+ */
+static bool sameElements(SPList list, SPUnrolledList unrolled) {
+	SPListElement e1 = spListGetFirst(list);
+	SPListElement e2 = spUnrolledListGetFirst(unrolled);
+	if (spListGetSize(list) != spUnrolledListGetSize(unrolled)) {
+		return false;
+	}
+	while (e1 && e2) {
+		if (spListElementCompare(e1, e2) != 0) {
+			return false;
+		}
+		e1 = spListGetNext(list);
+		e2 = spUnrolledListGetNext(unrolled);
+	}
+	if (e1 || e2) {
+		return false;
+	}
+	e1 = spListGetLast(list);
+	e2 = spUnrolledListGetLast(unrolled);
+	while (e1 && e2) {
+		if (spListElementCompare(e1, e2) != 0) {
+			return false;
+		}
+		e1 = spListGetPrevious(list);
+		e2 = spUnrolledListGetPrevious(unrolled);
+	}
+	return !e1 && !e2;
+}
+
+static bool unrolledListCreateTest() {
+	SPUnrolledList list = spUnrolledListCreate();
+	SPListElement e = spListElementCreate(1, 1.0);
+	ASSERT_TRUE(list != NULL);
+	ASSERT_TRUE(spUnrolledListGetSize(list) == 0);
+	ASSERT_TRUE(spUnrolledListGetSize(NULL) == -1);
+	ASSERT_TRUE(spUnrolledListGetFirst(list) == NULL);
+	ASSERT_TRUE(spUnrolledListGetCurrent(list) == NULL);
+	ASSERT_TRUE(spUnrolledListInsertFirst(NULL, e) == SP_LIST_NULL_ARGUMENT);
+	ASSERT_TRUE(spUnrolledListInsertBeforeCurrent(list, e) == SP_LIST_INVALID_CURRENT);
+	ASSERT_TRUE(spUnrolledListRemoveCurrent(list) == SP_LIST_INVALID_CURRENT);
+	spUnrolledListDestroy(list);
+	spListElementDestroy(e);
+	return true;
+}
+
+static bool unrolledListInsertTest() {
+	SPUnrolledList list = spUnrolledListCreate();
+	SPListElement e = spListElementCreate(0, 0.0);
+	int i = 0;
+	for (i = 0; i < 20; i++) {
+		spListElementSetIndex(e, i);
+		ASSERT_TRUE(spUnrolledListInsertLast(list, e) == SP_LIST_SUCCESS);
+	}
+	// Move to element 7 and insert around it, which splits its chunk
+	spUnrolledListGetFirst(list);
+	for (i = 0; i < 7; i++) {
+		spUnrolledListGetNext(list);
+	}
+	for (i = 100; i < 110; i++) {
+		spListElementSetIndex(e, i);
+		ASSERT_TRUE(spUnrolledListInsertBeforeCurrent(list, e) == SP_LIST_SUCCESS);
+		ASSERT_TRUE(spUnrolledListInsertAfterCurrent(list, e) == SP_LIST_SUCCESS);
+		ASSERT_TRUE(spListElementGetIndex(spUnrolledListGetCurrent(list)) == 7);
+	}
+	ASSERT_TRUE(spUnrolledListGetSize(list) == 40);
+	ASSERT_TRUE(spListElementGetIndex(spUnrolledListGetPrevious(list)) == 109);
+	ASSERT_TRUE(spListElementGetIndex(spUnrolledListGetNext(list)) == 7);
+	ASSERT_TRUE(spListElementGetIndex(spUnrolledListGetNext(list)) == 109);
+	i = 0;
+	SP_UNROLLED_LIST_FOREACH(SPListElement, element, list) {
+		i++;
+	}
+	ASSERT_TRUE(i == 40);
+	spUnrolledListDestroy(list);
+	spListElementDestroy(e);
+	return true;
+}
+
+static bool unrolledListRandomTest() {
+	SPList list = spListCreate();
+	SPUnrolledList unrolled = spUnrolledListCreate();
+	SPUnrolledList copy;
+	SPListElement e = spListElementCreate(0, 0.0);
+	unsigned int seed = 12345;
+	int i, steps, operation;
+	for (i = 0; i < OPERATIONS; i++) {
+		seed = seed * 1103515245u + 12345u;
+		operation = (seed >> 16) % 6;
+		spListElementSetIndex(e, i);
+		spListElementSetValue(e, (double) (seed % 100));
+		if (operation == 0) {
+			spListInsertFirst(list, e);
+			spUnrolledListInsertFirst(unrolled, e);
+		} else if (operation == 1) {
+			spListInsertLast(list, e);
+			spUnrolledListInsertLast(unrolled, e);
+		} else {
+			// Move both iterators to the same random position
+			steps = spListGetSize(list) == 0 ? 0 : (int) (seed % spListGetSize(list));
+			spListGetFirst(list);
+			spUnrolledListGetFirst(unrolled);
+			while (steps-- > 0) {
+				spListGetNext(list);
+				spUnrolledListGetNext(unrolled);
+			}
+			if (operation == 2) {
+				ASSERT_TRUE(spListInsertBeforeCurrent(list, e) ==
+						spUnrolledListInsertBeforeCurrent(unrolled, e));
+			} else if (operation == 3) {
+				ASSERT_TRUE(spListInsertAfterCurrent(list, e) ==
+						spUnrolledListInsertAfterCurrent(unrolled, e));
+			} else {
+				ASSERT_TRUE(spListRemoveCurrent(list) ==
+						spUnrolledListRemoveCurrent(unrolled));
+			}
+		}
+		if (i % 500 == 0) {
+			ASSERT_TRUE(sameElements(list, unrolled));
+		}
+	}
+	ASSERT_TRUE(sameElements(list, unrolled));
+	copy = spUnrolledListCopy(unrolled);
+	ASSERT_TRUE(sameElements(list, copy));
+	ASSERT_TRUE(spUnrolledListClear(unrolled) == SP_LIST_SUCCESS);
+	ASSERT_TRUE(spUnrolledListGetSize(unrolled) == 0);
+	ASSERT_TRUE(spUnrolledListGetLast(unrolled) == NULL);
+	spUnrolledListDestroy(copy);
+	spUnrolledListDestroy(unrolled);
+	spListDestroy(list);
+	spListElementDestroy(e);
+	return true;
+}
+
+int main() {
+	RUN_TEST(unrolledListCreateTest);
+	RUN_TEST(unrolledListInsertTest);
+	RUN_TEST(unrolledListRandomTest);
+	return 0;
+}